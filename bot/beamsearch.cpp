@@ -0,0 +1,164 @@
+#include "beamsearch.h"
+#include "../model/movegenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+using namespace GJ_GW;
+
+BeamSearch::BeamSearch(unsigned width, unsigned threads, std::chrono::milliseconds budget):
+    width_{width}, threads_{threads}, budget_{budget}, tableBits_{0}{
+    if(width_ == 0){
+        throw std::invalid_argument("la largeur du faisceau doit être non nulle");
+    }
+    if(threads_ == 0){
+        throw std::invalid_argument("le nombre de threads doit être non nul");
+    }
+    while(tableBits_ < TranspositionTable::MAXIMUM_BITS
+          && (std::uint64_t(1) << tableBits_) < std::uint64_t(width_) * TABLE_LOAD){
+        ++tableBits_;
+    }
+    if(threads_ > 1){
+        pool_.reset(new WorkStealingPool(threads_ - 1));
+    }
+}
+
+std::chrono::milliseconds BeamSearch::getBudget() const{
+    return budget_;
+}
+
+std::vector<Placement> BeamSearch::search(const Board & board, const Bric & current, bool placed,
+                                          const std::vector<Bric> & previews) const{
+    const auto deadline = std::chrono::steady_clock::now() + budget_;
+    std::vector<Placement> placements;
+    MoveGenerator::generate(board, current, placed, placements);
+    std::vector<Node> beam;
+    beam.reserve(placements.size());
+    for(const Placement & placement : placements){
+        beam.push_back(Node{board, {}, 1, 0, 0, 0});
+        Node & node {beam.back()};
+        node.plan[0] = placement;
+        node.reward = LINES_WEIGHT * MoveGenerator::apply(node.board, current, placed, placement);
+    }
+    evaluate(beam);
+    select(beam);
+
+    const std::size_t levels {std::min<std::size_t>(previews.size(), BricsBag::MAXIMUM_PREVIEW)};
+    std::vector<Node> children;
+    TranspositionTable table {tableBits_};
+    for(std::size_t level {0}; level < levels && !beam.empty(); ++level){
+        if(!expand(beam, MoveGenerator::spawn(previews[level], board.getWidth()), deadline, table, children)
+                || children.empty()){
+            break;
+        }
+        select(children);
+        beam.swap(children);
+    }
+    if(beam.empty()){
+        return {};
+    }
+    return std::vector<Placement>(beam.front().plan.begin(), beam.front().plan.begin() + beam.front().depth);
+}
+
+bool BeamSearch::expand(const std::vector<Node> & beam, const Bric & bric,
+                        std::chrono::steady_clock::time_point deadline, TranspositionTable & table,
+                        std::vector<Node> & children) const{
+    static_assert(MoveGenerator::MAXIMUM_PLACEMENTS <= (1u << 11), "le numéro d'ordre réserve 11 bits à la position");
+    table.clear();
+    const unsigned threads {static_cast<unsigned>(std::min<std::size_t>(threads_, beam.size()))};
+    std::vector<std::vector<Node>> parts(threads);
+    std::atomic<bool> late {0};
+    auto work = [&](unsigned part){
+        std::vector<Placement> placements;
+        std::vector<Node> & nodes {parts[part]};
+        for(std::size_t i {part * beam.size() / threads};
+            i < (part + 1) * beam.size() / threads && !late.load(std::memory_order_relaxed); ++i){
+            const Node & parent {beam[i]};
+            MoveGenerator::generate(parent.board, bric, false, placements);
+            for(std::size_t j {0}; j < placements.size(); ++j){
+                nodes.push_back(parent);
+                Node & child {nodes.back()};
+                child.plan[child.depth++] = placements[j];
+                child.reward += LINES_WEIGHT * MoveGenerator::apply(child.board, bric, false, placements[j]);
+                child.order = static_cast<std::uint32_t>(i << 11 | j);
+                table.offer(child.board.getHash(), child.order);
+            }
+            if(budget_.count() != 0 && std::chrono::steady_clock::now() > deadline){
+                late.store(1, std::memory_order_relaxed);
+            }
+        }
+        if(!late.load(std::memory_order_relaxed)){
+            evaluate(nodes);
+        }
+    };
+    // le groupe peut servir à plusieurs recherches à la fois : on n'attend que les parts de ce niveau
+    std::mutex mutex;
+    std::condition_variable done;
+    unsigned remaining {threads - 1};
+    for(unsigned u {1}; u < threads; ++u){
+        pool_->submit([&, u]{
+            work(u);
+            std::lock_guard<std::mutex> lock {mutex};
+            if(--remaining == 0){
+                done.notify_one();
+            }
+        });
+    }
+    work(0);
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        done.wait(lock, [&remaining]{ return remaining == 0; });
+    }
+    children.clear();
+    if(late){
+        return false;
+    }
+    std::size_t total {0};
+    for(const std::vector<Node> & part : parts){
+        total += part.size();
+    }
+    children.reserve(total);
+    for(std::vector<Node> & part : parts){
+        for(Node & child : part){
+            if(table.isFirst(child.board.getHash(), child.order)){
+                children.push_back(std::move(child));
+            }
+        }
+    }
+    return true;
+}
+
+void BeamSearch::select(std::vector<Node> & nodes) const{
+    auto better = [](const Node & a, const Node & b){
+        return a.value > b.value;
+    };
+    if(nodes.size() > width_){
+        std::partial_sort(nodes.begin(), nodes.begin() + width_, nodes.end(), better);
+        nodes.erase(nodes.begin() + width_, nodes.end());
+    } else{
+        std::sort(nodes.begin(), nodes.end(), better);
+    }
+}
+
+void BeamSearch::evaluate(std::vector<Node> & nodes){
+    if(nodes.empty()){
+        return;
+    }
+    BoardBatch batch {nodes.front().board.getWidth(), nodes.front().board.getHeight()};
+    for(const Node & node : nodes){
+        batch.add(node.board);
+    }
+    Features features;
+    Evaluator::compute(batch, features);
+    for(std::size_t i {0}; i < nodes.size(); ++i){
+        nodes[i].value = nodes[i].reward
+                + HEIGHT_WEIGHT * features.height[i]
+                + HOLES_WEIGHT * features.holes[i]
+                + BUMPINESS_WEIGHT * features.bumpiness[i]
+                + TRANSITIONS_WEIGHT * features.transitions[i]
+                + WELLS_WEIGHT * features.wells[i];
+    }
+}
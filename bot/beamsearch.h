@@ -0,0 +1,176 @@
+#ifndef BEAMSEARCH_H
+#define BEAMSEARCH_H
+
+#include "../model/board.h"
+#include "../model/bric.h"
+#include "../model/bricsBag.h"
+#include "../model/placement.h"
+#include "../model/workstealingpool.h"
+#include "evaluator.h"
+#include "transpositiontable.h"
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe cherchant où poser les prochaines \ref Bric par une recherche en faisceau.
+ *
+ * Chaque niveau de la recherche pose une brique : la brique courante puis les
+ * briques à venir, dans l'ordre. Toutes les positions finales données par
+ * \ref MoveGenerator sont essayées sur chaque grille du faisceau et seules les
+ * meilleures grilles, selon une évaluation heuristique, sont gardées pour le
+ * niveau suivant. Les grilles d'un niveau sont réparties entre plusieurs threads,
+ * chacun évaluant les siennes en un lot par l'\ref Evaluator. Ces threads sont
+ * ceux d'un \ref WorkStealingPool créé avec la recherche : aucun thread n'est
+ * lancé ni arrêté pendant une recherche.
+ *
+ * Plusieurs ordres de pose menant souvent à la même grille, chaque niveau ne
+ * garde qu'un exemplaire de chaque grille, reconnue par sa clé de \ref Zobrist
+ * dans une \ref TranspositionTable partagée par les threads.
+ *
+ * Si le temps alloué est écoulé au cours d'un niveau, celui-ci est abandonné et
+ * le meilleur plan du niveau précédent est renvoyé. Le 1er niveau est toujours
+ * terminé. Sans limite de temps, le résultat ne dépend pas du nombre de threads.
+ */
+class BeamSearch{
+public:
+    constexpr static unsigned DEFAULT_WIDTH {64};
+    /*!< Le nombre de grilles gardées par niveau par défaut. */
+
+    constexpr static double HEIGHT_WEIGHT {-0.510066};
+    /*!< Le poids de la somme des hauteurs des colonnes. */
+
+    constexpr static double LINES_WEIGHT {0.760666};
+    /*!< Le poids de chaque ligne vidée. */
+
+    constexpr static double HOLES_WEIGHT {-0.35663};
+    /*!< Le poids du nombre de trous. */
+
+    constexpr static double BUMPINESS_WEIGHT {-0.184483};
+    /*!< Le poids de la somme des différences de hauteur entre colonnes voisines. */
+
+    constexpr static double TRANSITIONS_WEIGHT {-0.1};
+    /*!< Le poids du nombre de passages entre case pleine et case vide le long des lignes. */
+
+    constexpr static double WELLS_WEIGHT {-0.05};
+    /*!< Le poids de la somme des profondeurs des puits. */
+
+    constexpr static unsigned TABLE_LOAD {512};
+    /*!< Le nombre d'entrées de la table de transposition par grille du faisceau,
+     * de quoi garder la table peu remplie quel que soit le nombre de positions. */
+
+private:
+    /*!
+     * \brief Structure représentant une grille du faisceau.
+     */
+    struct Node{
+        Board board;
+        /*!< La grille après la pose des briques du plan. */
+
+        std::array<Placement, BricsBag::MAXIMUM_PREVIEW + 1> plan;
+        /*!< Les positions finales choisies, une par brique posée. */
+
+        unsigned depth;
+        /*!< Le nombre de briques posées. */
+
+        double reward;
+        /*!< La récompense des lignes vidées depuis la racine. */
+
+        double value;
+        /*!< La valeur de la grille : la récompense plus l'évaluation de la grille. */
+
+        std::uint32_t order;
+        /*!< Le numéro d'ordre de la grille dans son niveau : l'indice de la grille
+         * parente et celui de la position finale. */
+    };
+
+    unsigned width_;
+    /*!< Le nombre de grilles gardées par niveau. */
+
+    unsigned threads_;
+    /*!< Le nombre de threads développant un niveau. */
+
+    std::chrono::milliseconds budget_;
+    /*!< Le temps alloué à une recherche, 0 pour aucune limite. */
+
+    unsigned tableBits_;
+    /*!< Le logarithme en base 2 du nombre d'entrées de la table de transposition. */
+
+    std::unique_ptr<WorkStealingPool> pool_;
+    /*!< Les threads aidant le thread appelant à développer un niveau,
+     * nullptr si la recherche n'utilise qu'un thread. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref BeamSearch.
+     *
+     * Les threads supplémentaires sont lancés ici et vivent aussi longtemps que la recherche.
+     *
+     * \param width le nombre de grilles gardées par niveau
+     * \param threads le nombre de threads développant un niveau, thread appelant compris
+     * \param budget le temps alloué à une recherche, 0 pour aucune limite
+     * \throw std::invalid_argument si la largeur ou le nombre de threads est nul
+     */
+    explicit BeamSearch(unsigned width = DEFAULT_WIDTH, unsigned threads = 1,
+                        std::chrono::milliseconds budget = std::chrono::milliseconds{0});
+
+    /*!
+     * \brief Méthode cherchant le meilleur plan de pose des prochaines briques.
+     *
+     * \param board la grille de jeu
+     * \param current la brique courante, dans sa position actuelle
+     * \param placed vrai si la brique courante est déjà dans la grille
+     * \param previews les briques à venir, au plus \ref BricsBag::MAXIMUM_PREVIEW sont utilisées
+     * \return les positions finales du meilleur plan, la 1ère étant celle de la brique courante,
+     * vide si la brique courante ne peut être posée
+     */
+    std::vector<Placement> search(const Board & board, const Bric & current, bool placed,
+                                  const std::vector<Bric> & previews) const;
+
+    /*!
+     * \brief Accesseur en lecture du temps alloué à une recherche.
+     * \return le temps alloué, 0 pour aucune limite
+     */
+    std::chrono::milliseconds getBudget() const;
+
+private:
+    /*!
+     * \brief Méthode posant une \ref Bric à toutes ses positions finales sur chaque grille du faisceau.
+     *
+     * \param beam les grilles du niveau
+     * \param bric la brique à poser, dans sa position de départ
+     * \param deadline l'instant auquel la recherche doit s'arrêter
+     * \param table la table de transposition, vidée au préalable
+     * \param children reçoit les grilles obtenues distinctes, dans l'ordre des grilles du niveau
+     * \return true si le niveau a été développé à temps, false sinon
+     */
+    bool expand(const std::vector<Node> & beam, const Bric & bric,
+                std::chrono::steady_clock::time_point deadline, TranspositionTable & table,
+                std::vector<Node> & children) const;
+
+    /*!
+     * \brief Méthode gardant les meilleures grilles d'un niveau, de la meilleure à la moins bonne.
+     * \param nodes les grilles du niveau
+     */
+    void select(std::vector<Node> & nodes) const;
+
+    /*!
+     * \brief Méthode évaluant des grilles en un lot.
+     *
+     * La valeur de chaque grille est sa récompense plus la somme pondérée de
+     * ses caractéristiques.
+     *
+     * \param nodes les grilles, de même taille
+     */
+    static void evaluate(std::vector<Node> & nodes);
+};
+
+} // namespace GJ_GW
+
+#endif // BEAMSEARCH_H
@@ -0,0 +1,95 @@
+#include "botplayer.h"
+#include "../model/gamestate.h"
+#include "../model/movegenerator.h"
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+#include <thread>
+
+using namespace GJ_GW;
+
+BotPlayer::BotPlayer(Tetris * game, unsigned lookahead, QObject * parent): QObject(parent),
+    game_{game},
+    search_{BeamSearch::DEFAULT_WIDTH, std::max(1u, std::thread::hardware_concurrency()),
+            std::chrono::milliseconds{DEFAULT_BUDGET}},
+    lookahead_{lookahead}, pieces_{0}, searched_{0}, planned_{0}, dropped_{0}{
+    timer_ = new QTimer(this);
+    timer_->setInterval(INTERVAL);
+    connect(timer_, SIGNAL(timeout()), this, SLOT(act()));
+    watcher_ = new QFutureWatcher<std::vector<Placement>>(this);
+    connect(watcher_, SIGNAL(finished()), this, SLOT(planned()));
+}
+
+BotPlayer::~BotPlayer(){
+    stop();
+    watcher_->waitForFinished();
+}
+
+void BotPlayer::start(){
+    if(!isActive()){
+        game_->setPreviewDepth(lookahead_);
+        game_->addEventObserver(this, GameEvent::mask(GameEventKind::PIECE_SPAWNED));
+        ++pieces_;
+        planned_ = 0;
+        dropped_ = 0;
+        timer_->start();
+    }
+}
+
+void BotPlayer::stop(){
+    if(isActive()){
+        timer_->stop();
+        game_->removeEventObserver(this);
+    }
+}
+
+bool BotPlayer::isActive() const{
+    return timer_->isActive();
+}
+
+void BotPlayer::onEvent(const GameEvent &){
+    ++pieces_;
+    planned_ = 0;
+    dropped_ = 0;
+}
+
+void BotPlayer::plan(){
+    std::vector<Bric> previews;
+    for(unsigned u {0}; u < game_->getPreviewDepth(); ++u){
+        previews.push_back(game_->getPreview(u));
+    }
+    searched_ = pieces_;
+    watcher_->setFuture(QtConcurrent::run([this, board = game_->getBoard(),
+                                           current = game_->getCurrentBric(), previews]{
+        return search_.search(board, current, true, previews);
+    }));
+}
+
+void BotPlayer::planned(){
+    std::vector<Placement> plan {watcher_->result()};
+    if(searched_ == pieces_ && !plan.empty()){
+        target_ = plan.front();
+        planned_ = 1;
+    }
+}
+
+void BotPlayer::act(){
+    if(game_->isPaused() || game_->getGameState() != GameState::ON || dropped_){
+        return;
+    }
+    if(!planned_){
+        if(!watcher_->isRunning()){
+            plan();
+        }
+        return;
+    }
+    std::vector<Input> inputs;
+    if(!MoveGenerator::path(game_->getBoard(), game_->getCurrentBric(), true, target_, inputs)){
+        planned_ = 0;
+        return;
+    }
+    if(inputs.front() == Input::DROP){
+        dropped_ = 1;
+    }
+    game_->step(inputs.front());
+}
@@ -0,0 +1,137 @@
+#ifndef BOTPLAYER_H
+#define BOTPLAYER_H
+
+#include "beamsearch.h"
+#include "../model/tetris.h"
+#include "../model/eventobserver.h"
+#include <QFutureWatcher>
+#include <QObject>
+#include <vector>
+
+class QTimer;
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe représentant un joueur automatique d'une partie de \ref Tetris.
+ *
+ * À chaque nouvelle \ref Bric, le joueur cherche en arrière-plan où la poser
+ * grâce à une \ref BeamSearch sur la brique courante et les briques à venir.
+ * Il joue ensuite une action par intervalle, passée à \ref Simulation::step
+ * comme celles du joueur humain : elles sont donc enregistrées et rejouées
+ * de la même façon. Le chemin vers la position choisie est recalculé avant
+ * chaque action, ce qui tient compte des descentes automatiques.
+ */
+class BotPlayer : public QObject, public EventObserver{
+    Q_OBJECT
+
+public:
+    constexpr static unsigned INTERVAL {25};
+    /*!< L'intervalle entre deux actions, en millisecondes. */
+
+    constexpr static unsigned DEFAULT_BUDGET {60};
+    /*!< Le temps alloué par défaut à la recherche d'une brique, en millisecondes. */
+
+private:
+    Tetris * game_;
+    /*!< La partie jouée. */
+
+    BeamSearch search_;
+    /*!< La recherche des positions des briques. */
+
+    unsigned lookahead_;
+    /*!< Le nombre de briques à venir prises en compte. */
+
+    QTimer * timer_;
+    /*!< Le minuteur des actions. */
+
+    QFutureWatcher<std::vector<Placement>> * watcher_;
+    /*!< Le suivi de la recherche en cours. */
+
+    unsigned pieces_;
+    /*!< Le nombre de briques mises en jeu depuis le démarrage du joueur. */
+
+    unsigned searched_;
+    /*!< La valeur de \ref pieces_ au lancement de la dernière recherche. */
+
+    bool planned_;
+    /*!< Vrai si \ref target_ est la position choisie pour la brique courante. */
+
+    bool dropped_;
+    /*!< Vrai si la brique courante a été droppée et attend d'être fixée. */
+
+    Placement target_;
+    /*!< La position choisie pour la brique courante. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref BotPlayer.
+     *
+     * La recherche utilise tous les cœurs et dispose de \ref DEFAULT_BUDGET
+     * millisecondes par brique.
+     *
+     * \param game la partie à jouer
+     * \param lookahead le nombre de briques à venir prises en compte,
+     * entre 1 et \ref BricsBag::MAXIMUM_PREVIEW
+     * \param parent l'objet parent
+     */
+    explicit BotPlayer(Tetris * game, unsigned lookahead = 1, QObject * parent = 0);
+
+    /*!
+     * \brief Destructeur de \ref BotPlayer.
+     *
+     * Il arrête le joueur et attend la fin de la recherche en cours.
+     */
+    ~BotPlayer();
+
+    /*!
+     * \brief Méthode démarrant le joueur sur la partie.
+     *
+     * La profondeur d'aperçu de la partie est portée à \ref lookahead_.
+     */
+    void start();
+
+    /*!
+     * \brief Méthode arrêtant le joueur.
+     */
+    void stop();
+
+    /*!
+     * \brief Méthode vérifiant si le joueur est démarré.
+     * \return true si le joueur joue, false sinon
+     */
+    bool isActive() const;
+
+    /*!
+     * \brief Méthode notant la mise en jeu d'une nouvelle \ref Bric.
+     *
+     * Le joueur n'est abonné qu'à \ref GameEventKind::PIECE_SPAWNED.
+     *
+     * \param event l'événement
+     */
+    void onEvent(const GameEvent & event) override;
+
+private:
+    /*!
+     * \brief Méthode lançant en arrière-plan la recherche de la position de la \ref Bric courante.
+     */
+    void plan();
+
+private slots:
+    /*!
+     * \brief Méthode jouant la prochaine action vers la position choisie.
+     */
+    void act();
+
+    /*!
+     * \brief Méthode récupérant le résultat de la recherche.
+     */
+    void planned();
+};
+
+} // namespace GJ_GW
+
+#endif // BOTPLAYER_H
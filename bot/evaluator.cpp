@@ -0,0 +1,195 @@
+#include "evaluator.h"
+#include <algorithm>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace GJ_GW;
+
+BoardBatch::BoardBatch(unsigned width, unsigned height): width_{width}, height_{height}, size_{0}{
+}
+
+void BoardBatch::add(const Board & board){
+    if(board.getWidth() != width_ || board.getHeight() != height_){
+        throw std::invalid_argument("la grille n'a pas la taille du lot");
+    }
+    if(size_ % LANES == 0){
+        for(unsigned x {0}; x < width_; ++x){
+            columns_[x].resize(size_ + LANES, 0);
+        }
+    }
+    for(unsigned x {0}; x < width_; ++x){
+        columns_[x][size_] = board.getColumn(x);
+    }
+    ++size_;
+}
+
+void BoardBatch::clear(){
+    for(unsigned x {0}; x < width_; ++x){
+        columns_[x].clear();
+    }
+    size_ = 0;
+}
+
+std::size_t BoardBatch::size() const{
+    return size_;
+}
+
+void Evaluator::compute(const BoardBatch & batch, Features & features){
+#ifdef __SSE2__
+    computeVector(batch, features);
+#else
+    computeScalar(batch, features);
+#endif
+}
+
+void Evaluator::resize(Features & features, std::size_t size){
+    features.height.resize(size);
+    features.holes.resize(size);
+    features.bumpiness.resize(size);
+    features.transitions.resize(size);
+    features.wells.resize(size);
+}
+
+void Evaluator::computeScalar(const BoardBatch & batch, Features & features){
+    resize(features, batch.size_);
+    const unsigned w {batch.width_};
+    const unsigned h {batch.height_};
+    for(std::size_t i {0}; i < batch.size_; ++i){
+        std::array<unsigned, Board::MAXIMUM_WIDTH> heights;
+        std::uint32_t holes {0};
+        std::uint32_t transitions {0};
+        for(unsigned x {0}; x < w; ++x){
+            Column column {batch.columns_[x][i]};
+            heights[x] = (column == 0)? 0 : h - __builtin_ctz(column);
+            holes += heights[x] - __builtin_popcount(column);
+            if(x > 0){
+                transitions += __builtin_popcount(column ^ batch.columns_[x - 1][i]);
+            }
+        }
+        const Column full {(h < 32)? (Column(1) << h) - 1 : ~Column(0)};
+        transitions += __builtin_popcount(~batch.columns_[0][i] & full)
+                + __builtin_popcount(~batch.columns_[w - 1][i] & full);
+        std::uint32_t bumpiness {0};
+        std::uint32_t wells {0};
+        for(unsigned x {0}; x < w; ++x){
+            unsigned left {(x > 0)? heights[x - 1] : h};
+            unsigned right {(x + 1 < w)? heights[x + 1] : h};
+            unsigned lowest {std::min(left, right)};
+            wells += (lowest > heights[x])? lowest - heights[x] : 0;
+            if(x > 0){
+                bumpiness += (heights[x] > left)? heights[x] - left : left - heights[x];
+            }
+        }
+        features.height[i] = 0;
+        for(unsigned x {0}; x < w; ++x){
+            features.height[i] += heights[x];
+        }
+        features.holes[i] = holes;
+        features.bumpiness[i] = bumpiness;
+        features.transitions[i] = transitions;
+        features.wells[i] = wells;
+    }
+}
+
+#ifdef __SSE2__
+
+namespace{
+
+/*!
+ * \brief Méthode comptant les bits de chaque mot de 32 bits.
+ * \param v les mots
+ * \return le nombre de bits à 1 de chaque mot
+ */
+inline __m128i popcount(__m128i v){
+    v = _mm_sub_epi32(v, _mm_and_si128(_mm_srli_epi32(v, 1), _mm_set1_epi32(0x55555555)));
+    v = _mm_add_epi32(_mm_and_si128(v, _mm_set1_epi32(0x33333333)),
+                      _mm_and_si128(_mm_srli_epi32(v, 2), _mm_set1_epi32(0x33333333)));
+    v = _mm_and_si128(_mm_add_epi32(v, _mm_srli_epi32(v, 4)), _mm_set1_epi32(0x0F0F0F0F));
+    v = _mm_add_epi32(v, _mm_srli_epi32(v, 8));
+    v = _mm_add_epi32(v, _mm_srli_epi32(v, 16));
+    return _mm_and_si128(v, _mm_set1_epi32(0x3F));
+}
+
+/*!
+ * \brief Méthode calculant la hauteur de chaque colonne.
+ *
+ * Chaque masque est étalé vers le bas de la grille, ses bits comptent alors
+ * les lignes entre la plus haute case pleine et le bas.
+ *
+ * \param column les colonnes
+ * \param full le masque d'une colonne pleine
+ * \return la hauteur de chaque colonne
+ */
+inline __m128i heights(__m128i column, __m128i full){
+    column = _mm_or_si128(column, _mm_slli_epi32(column, 1));
+    column = _mm_or_si128(column, _mm_slli_epi32(column, 2));
+    column = _mm_or_si128(column, _mm_slli_epi32(column, 4));
+    column = _mm_or_si128(column, _mm_slli_epi32(column, 8));
+    column = _mm_or_si128(column, _mm_slli_epi32(column, 16));
+    return popcount(_mm_and_si128(column, full));
+}
+
+/*!
+ * \brief Méthode calculant la valeur absolue de chaque mot signé.
+ * \param v les mots
+ * \return les valeurs absolues
+ */
+inline __m128i absolute(__m128i v){
+    __m128i sign {_mm_srai_epi32(v, 31)};
+    return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+}
+
+} // namespace
+
+void Evaluator::computeVector(const BoardBatch & batch, Features & features){
+    const std::size_t padded {(batch.size_ + BoardBatch::LANES - 1) / BoardBatch::LANES * BoardBatch::LANES};
+    resize(features, padded);
+    const unsigned w {batch.width_};
+    const unsigned h {batch.height_};
+    const __m128i full {_mm_set1_epi32(static_cast<int>((h < 32)? (Column(1) << h) - 1 : ~Column(0)))};
+    const __m128i wall {_mm_set1_epi32(static_cast<int>(h))};
+    const __m128i zero {_mm_setzero_si128()};
+    for(std::size_t i {0}; i < padded; i += BoardBatch::LANES){
+        auto load = [&batch, i](unsigned x){
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(batch.columns_[x].data() + i));
+        };
+        __m128i column {load(0)};
+        __m128i height {heights(column, full)};
+        __m128i left {wall};
+        __m128i total {height};
+        __m128i holes {_mm_sub_epi32(height, popcount(column))};
+        __m128i bumpiness {zero};
+        __m128i transitions {popcount(_mm_andnot_si128(column, full))};
+        __m128i wells {zero};
+        for(unsigned x {1}; x <= w; ++x){
+            __m128i right {wall};
+            if(x < w){
+                __m128i next {load(x)};
+                right = heights(next, full);
+                total = _mm_add_epi32(total, right);
+                holes = _mm_add_epi32(holes, _mm_sub_epi32(right, popcount(next)));
+                bumpiness = _mm_add_epi32(bumpiness, absolute(_mm_sub_epi32(right, height)));
+                transitions = _mm_add_epi32(transitions, popcount(_mm_xor_si128(column, next)));
+                column = next;
+            } else{
+                transitions = _mm_add_epi32(transitions, popcount(_mm_andnot_si128(column, full)));
+            }
+            __m128i higher {_mm_cmpgt_epi32(left, right)};
+            __m128i lowest {_mm_or_si128(_mm_and_si128(higher, right), _mm_andnot_si128(higher, left))};
+            __m128i depth {_mm_sub_epi32(lowest, height)};
+            wells = _mm_add_epi32(wells, _mm_andnot_si128(_mm_srai_epi32(depth, 31), depth));
+            left = height;
+            height = right;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(features.height.data() + i), total);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(features.holes.data() + i), holes);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(features.bumpiness.data() + i), bumpiness);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(features.transitions.data() + i), transitions);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(features.wells.data() + i), wells);
+    }
+    resize(features, batch.size_);
+}
+
+#endif
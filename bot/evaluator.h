@@ -0,0 +1,150 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "../model/board.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe regroupant des grilles de même taille pour les évaluer ensemble.
+ *
+ * Les grilles sont rangées en structure de tableaux : la colonne x de toutes
+ * les grilles est contiguë, ce qui permet de traiter plusieurs grilles par
+ * instruction. Les colonnes sont complétées par des grilles vides jusqu'à un
+ * multiple de \ref LANES.
+ */
+class BoardBatch{
+    friend class Evaluator;
+
+public:
+    constexpr static unsigned LANES {4};
+    /*!< Le nombre de grilles traitées par instruction, des \ref Column de 32 bits dans 128 bits. */
+
+private:
+    unsigned width_;
+    /*!< La largeur des grilles. */
+
+    unsigned height_;
+    /*!< La hauteur des grilles. */
+
+    std::size_t size_;
+    /*!< Le nombre de grilles. */
+
+    std::array<std::vector<Column>, Board::MAXIMUM_WIDTH> columns_;
+    /*!< Les colonnes des grilles, columns_[x][i] étant la colonne x de la grille i. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref BoardBatch.
+     *
+     * \param width la largeur des grilles
+     * \param height la hauteur des grilles
+     */
+    BoardBatch(unsigned width, unsigned height);
+
+    /*!
+     * \brief Méthode ajoutant une grille au lot.
+     *
+     * \param board la grille, de la taille du lot
+     * \throw std::invalid_argument si la grille n'a pas la taille du lot
+     */
+    void add(const Board & board);
+
+    /*!
+     * \brief Méthode vidant le lot en conservant sa capacité.
+     */
+    void clear();
+
+    /*!
+     * \brief Accesseur en lecture du nombre de grilles du lot.
+     * \return le nombre de grilles
+     */
+    std::size_t size() const;
+};
+
+/*!
+ * \brief Structure regroupant les caractéristiques des grilles d'un \ref BoardBatch.
+ *
+ * Chaque tableau contient une valeur par grille, dans l'ordre du lot.
+ */
+struct Features{
+    std::vector<std::uint32_t> height;
+    /*!< La somme des hauteurs des colonnes. */
+
+    std::vector<std::uint32_t> holes;
+    /*!< Le nombre de cases vides sous la plus haute case pleine de leur colonne. */
+
+    std::vector<std::uint32_t> bumpiness;
+    /*!< La somme des différences de hauteur entre colonnes voisines. */
+
+    std::vector<std::uint32_t> transitions;
+    /*!< Le nombre de passages entre case pleine et case vide le long des lignes,
+     * les bords de la grille comptant comme pleins. */
+
+    std::vector<std::uint32_t> wells;
+    /*!< La somme des profondeurs des puits : pour chaque colonne, de combien elle est
+     * plus basse que la moins haute de ses voisines, les bords comptant comme pleins. */
+};
+
+/*!
+ * \brief Classe calculant les caractéristiques heuristiques d'un lot de grilles.
+ *
+ * Toutes les caractéristiques sont déduites des colonnes (\ref Column) :
+ * la hauteur d'une colonne est le nombre de bits de son masque étalé vers le bas,
+ * ses trous sont cette hauteur moins le nombre de ses cases pleines, et les
+ * passages le long des lignes entre deux colonnes voisines sont les bits de
+ * leur OU exclusif.
+ *
+ * Lorsque le processeur dispose de SSE2, \ref compute traite \ref BoardBatch::LANES
+ * grilles à la fois, avec un comptage de bits par décalages et masques.
+ * La version scalaire donne exactement les mêmes résultats.
+ */
+class Evaluator{
+public:
+    /*!
+     * \brief Méthode calculant les caractéristiques d'un lot, par la version vectorielle
+     * si elle est disponible.
+     *
+     * \param batch le lot de grilles
+     * \param features reçoit les caractéristiques, redimensionnées à la taille du lot
+     */
+    static void compute(const BoardBatch & batch, Features & features);
+
+    /*!
+     * \brief Méthode calculant les caractéristiques d'un lot, une grille à la fois.
+     *
+     * \param batch le lot de grilles
+     * \param features reçoit les caractéristiques, redimensionnées à la taille du lot
+     */
+    static void computeScalar(const BoardBatch & batch, Features & features);
+
+#ifdef __SSE2__
+    /*!
+     * \brief Méthode calculant les caractéristiques d'un lot, \ref BoardBatch::LANES
+     * grilles à la fois.
+     *
+     * \param batch le lot de grilles
+     * \param features reçoit les caractéristiques, redimensionnées à la taille du lot
+     */
+    static void computeVector(const BoardBatch & batch, Features & features);
+#endif
+
+private:
+    /*!
+     * \brief Méthode redimensionnant les caractéristiques.
+     *
+     * \param features les caractéristiques
+     * \param size le nombre de grilles
+     */
+    static void resize(Features & features, std::size_t size);
+};
+
+} // namespace GJ_GW
+
+#endif // EVALUATOR_H
@@ -0,0 +1,54 @@
+#include "transpositiontable.h"
+#include <stdexcept>
+#include <string>
+
+using namespace GJ_GW;
+
+TranspositionTable::TranspositionTable(unsigned bits){
+    if(bits > MAXIMUM_BITS){
+        throw std::invalid_argument("la table de transposition ne peut dépasser 2^"
+                                    + std::to_string(MAXIMUM_BITS) + " entrées");
+    }
+    mask_ = (std::size_t(1) << bits) - 1;
+    entries_.reset(new std::atomic<std::uint64_t>[mask_ + 1]);
+    clear();
+}
+
+void TranspositionTable::clear(){
+    for(std::size_t i {0}; i <= mask_; ++i){
+        entries_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t TranspositionTable::tag(std::uint64_t hash){
+    return ((hash >> 32) | 1) << 32;
+}
+
+void TranspositionTable::offer(std::uint64_t hash, std::uint32_t order){
+    const std::uint64_t mine {tag(hash) | order};
+    for(unsigned u {0}; u < PROBES; ++u){
+        std::atomic<std::uint64_t> & entry {entries_[(hash + u) & mask_]};
+        std::uint64_t current {entry.load(std::memory_order_relaxed)};
+        while(current == 0 || ((current & ~0xffffffffull) == tag(hash) && mine < current)){
+            if(entry.compare_exchange_weak(current, mine, std::memory_order_relaxed)){
+                return;
+            }
+        }
+        if((current & ~0xffffffffull) == tag(hash)){
+            return;
+        }
+    }
+}
+
+bool TranspositionTable::isFirst(std::uint64_t hash, std::uint32_t order) const{
+    for(unsigned u {0}; u < PROBES; ++u){
+        std::uint64_t current {entries_[(hash + u) & mask_].load(std::memory_order_relaxed)};
+        if(current == 0){
+            return true;
+        }
+        if((current & ~0xffffffffull) == tag(hash)){
+            return static_cast<std::uint32_t>(current) == order;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe représentant une table de transposition de taille fixe, partagée
+ * sans verrou entre les threads d'une recherche.
+ *
+ * Chaque entrée est un mot atomique de 64 bits : les 32 bits de poids fort
+ * de la clé de \ref Zobrist d'un état et le plus petit numéro d'ordre proposé
+ * pour cet état. Une clé est cherchée dans \ref PROBES entrées consécutives ;
+ * si elles sont toutes prises par d'autres clés, l'état n'est pas retenu et
+ * sera simplement traité comme nouveau.
+ *
+ * Garder le plus petit numéro d'ordre, plutôt que le premier arrivé, rend
+ * le résultat indépendant de l'ordre d'exécution des threads.
+ */
+class TranspositionTable{
+public:
+    constexpr static unsigned PROBES {8};
+    /*!< Le nombre d'entrées examinées pour une clé. */
+
+    constexpr static unsigned MAXIMUM_BITS {28};
+    /*!< Le plus grand logarithme en base 2 du nombre d'entrées. */
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> entries_;
+    /*!< Les entrées, 0 désignant une entrée libre. */
+
+    std::size_t mask_;
+    /*!< Le nombre d'entrées moins 1. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref TranspositionTable.
+     *
+     * \param bits le logarithme en base 2 du nombre d'entrées
+     * \throw std::invalid_argument si bits dépasse \ref MAXIMUM_BITS
+     */
+    explicit TranspositionTable(unsigned bits);
+
+    /*!
+     * \brief Méthode vidant la table.
+     *
+     * Elle ne doit pas être appelée pendant que d'autres threads utilisent la table.
+     */
+    void clear();
+
+    /*!
+     * \brief Méthode proposant un numéro d'ordre pour un état.
+     *
+     * La table garde le plus petit numéro proposé pour chaque état.
+     *
+     * \param hash la clé de l'état
+     * \param order le numéro d'ordre
+     */
+    void offer(std::uint64_t hash, std::uint32_t order);
+
+    /*!
+     * \brief Méthode vérifiant si un numéro d'ordre est le plus petit proposé pour un état.
+     *
+     * \param hash la clé de l'état
+     * \param order le numéro d'ordre
+     * \return false si un numéro plus petit a été proposé pour l'état, true sinon
+     */
+    bool isFirst(std::uint64_t hash, std::uint32_t order) const;
+
+private:
+    /*!
+     * \brief Méthode calculant l'étiquette rangée dans une entrée.
+     * \param hash la clé de l'état
+     * \return les 32 bits de poids fort de la clé, jamais nuls
+     */
+    static std::uint64_t tag(std::uint64_t hash);
+};
+
+} // namespace GJ_GW
+
+#endif // TRANSPOSITIONTABLE_H
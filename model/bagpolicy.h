@@ -0,0 +1,24 @@
+#ifndef BAGPOLICY_H
+#define BAGPOLICY_H
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Énumération fortement typée pour représenter la manière dont le
+ * \ref BricsBag tire les briques.
+ */
+enum class BagPolicy{
+    /*! La brique tirée n'est ni la brique courante ni la précédente, comme à l'origine du jeu. */
+    SWAP_SHUFFLE,
+    /*! Toutes les briques du sac sont distribuées dans un ordre aléatoire avant d'en remélanger un nouveau. */
+    SEVEN_BAG,
+    /*! La brique est retirée tant qu'elle fait partie des dernières tirées, un nombre limité de fois. */
+    HISTORY
+};
+
+} // namespace GJ_GW
+
+#endif // BAGPOLICY_H
@@ -1,19 +1,22 @@
 #include "board.h"
-#include "linestate.h"
 #include "bric.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
 
 using namespace GJ_GW;
 
 Board::Board(unsigned width, unsigned height): width_{width}, height_{height}{
-    for(unsigned u {0}; u < width; ++u){
-        for(unsigned j{0}; j < height; ++j){
-            grid_.emplace(std::pair<Position,Color>{Position(u, j), Color()});
-        }
+    if(width_ > MAXIMUM_WIDTH || height_ > MAXIMUM_HEIGHT){
+        throw std::invalid_argument("la grille dépasse la taille maximale du bitboard");
     }
-}
-
-std::map<Position, Color> Board::getGrid() const{
-    return grid_;
+    kernel_ = &BoardKernel::select(width_, height_);
+    fullRow_ = static_cast<Row>((1u << width_) - 1);
+    rows_.fill(0);
+    columns_.fill(0);
+    cells_.fill(0);
+    hash_ = 0;
+    clearDirty();
 }
 
 unsigned Board::getHeight() const{
@@ -24,105 +27,167 @@ unsigned Board::getWidth() const{
     return width_;
 }
 
-bool Board::contains(Position & pos) const{
-    return pos.getX() < width_ && pos.getY() < height_;
+unsigned Board::getColumnHeight(unsigned x) const{
+    if(columns_[x] == 0){
+        return 0;
+    }
+    return height_ - __builtin_ctz(columns_[x]);
 }
 
-bool Board::checkCase(Position & pos) const{
-    if(contains(pos))
-        return grid_.at(pos) == Color();
-    return 0;
+unsigned Board::getColumnHoles(unsigned x) const{
+    return getColumnHeight(x) - __builtin_popcount(columns_[x]);
 }
 
-bool Board::checkCase(unsigned &x, unsigned &y) const{
-    return grid_.at(Position(x, y)) == Color();
+unsigned Board::dropDistance(const Bric & bric) const{
+    const Bric::Orientation & o {bric.orientations_[bric.rotation_]};
+    unsigned left {bric.middle_.getX() + o.left};
+    unsigned top {bric.middle_.getY() + o.top};
+    unsigned distance {height_};
+    for(unsigned u {0}; u < o.width; ++u){
+        Column bricColumn {0};
+        for(unsigned v {0}; v < o.height; ++v){
+            if((o.rows[v] >> u) & 1u){
+                bricColumn |= Column(1) << (top + v);
+            }
+        }
+        Column obstacles {columns_[left + u] & ~bricColumn};
+        Column cells {bricColumn};
+        while(cells != 0){
+            unsigned y = __builtin_ctz(cells);
+            cells &= cells - 1;
+            Column below {(y + 1 < MAXIMUM_HEIGHT)? obstacles & ~((Column(2) << y) - 1) : 0};
+            unsigned floor {(below == 0)? height_ : static_cast<unsigned>(__builtin_ctz(below))};
+            if(floor - y - 1 < distance){
+                distance = floor - y - 1;
+            }
+        }
+    }
+    return distance;
 }
 
-unsigned Board::checkColumn(unsigned y){
-    unsigned u {height_-1};
-    if(y > u){
-        throw std::invalid_argument("la ligne est hors de la grille");
-    }
-    LineState state {checkRow(u)};
-    while(state != LineState::FILL && u > y){
-        --u;
-        state = checkRow(u);
-    }
-    if(state == LineState::FILL){
-        u = gridActualisation(u);
-    } else{
-        u = 0;
-    }
-    return u;
+bool Board::contains(Position & pos) const{
+    return pos.getX() < width_ && pos.getY() < height_;
 }
 
-LineState Board::checkRow(unsigned & y) const{
-    LineState state {LineState::NONE};
-    unsigned count {0};
-    if(checkCase(count, y)){
-        state = LineState::EMPTY;
-    } else{
-        state = LineState::FILL;
-    }
-    while(state != LineState::BOTH && count < width_){
-        if((state == LineState::FILL && checkCase(count, y)) || (state == LineState::EMPTY && ! checkCase(count, y))){
-            state = LineState::BOTH;
+bool Board::checkBric(const Bric & bric, unsigned rotation, int x, int y, bool placed) const{
+    const Bric::Orientation & o {bric.orientations_[rotation]};
+    int left {x + o.left};
+    int top {y + o.top};
+    std::array<Row, Bric::MAXIMUM_SIDE> ignored {};
+    if(placed){
+        for(unsigned v {0}; v < o.height; ++v){
+            ignored[v] = bric.getRowMask(top + v);
         }
-        ++count;
     }
-    return state;
+    return kernel_->fits(rows_.data(), o.rows.data(), o.width, o.height, left, top,
+                         ignored.data(), width_, height_);
 }
 
-void Board::swapCase(Position &pos, Color color){
-    (grid_.at(pos) == Color())? grid_.at(pos) = color : grid_.at(pos) = Color();
+void Board::addBric(const Bric & bric){
+    const Bric::Orientation & o {bric.orientations_[bric.rotation_]};
+    std::uint8_t color {bric.paletteIndex_};
+    unsigned left {bric.middle_.getX() + o.left};
+    unsigned top {bric.middle_.getY() + o.top};
+    for(unsigned v {0}; v < o.height; ++v){
+        hash_ ^= Zobrist::row(top + v, (o.rows[v] << left) & ~rows_[top + v]);
+        rows_[top + v] |= o.rows[v] << left;
+        markDirty(top + v, o.rows[v] << left);
+        for(unsigned u {0}; u < o.width; ++u){
+            if((o.rows[v] >> u) & 1u){
+                columns_[left + u] |= Column(1) << (top + v);
+                cells_[index(left + u, top + v)] = color;
+            }
+        }
+    }
 }
 
-void Board::EmptyRow(unsigned y){
-    for(unsigned u {0}; u < width_; ++u){
-        Position pos {Position(u, y)};
-        swapCase(pos, Color());
+void Board::removeBric(const Bric & bric){
+    const Bric::Orientation & o {bric.orientations_[bric.rotation_]};
+    unsigned left {bric.middle_.getX() + o.left};
+    unsigned top {bric.middle_.getY() + o.top};
+    for(unsigned v {0}; v < o.height; ++v){
+        hash_ ^= Zobrist::row(top + v, (o.rows[v] << left) & rows_[top + v]);
+        rows_[top + v] &= ~(o.rows[v] << left);
+        markDirty(top + v, o.rows[v] << left);
+        for(unsigned u {0}; u < o.width; ++u){
+            if((o.rows[v] >> u) & 1u){
+                columns_[left + u] &= ~(Column(1) << (top + v));
+                cells_[index(left + u, top + v)] = 0;
+            }
+        }
     }
 }
 
-void Board::moveLine(unsigned y, int lineNb){
-    for(unsigned u {0}; u < width_; ++u){
-        if(! checkCase(u, y)){
-            Position pos {Position(u, y)};
-            Color temp {grid_.at(pos)};
-            swapCase(pos, Color());
-            pos = Position(pos.getX(),pos.getY()+lineNb);
-            swapCase(pos, temp);
+Column Board::getFullRows() const{
+    return kernel_->fullRows(rows_.data(), width_, height_);
+}
+
+Column Board::clearLines(){
+    std::array<Row, MAXIMUM_HEIGHT> before {rows_};
+    Column cleared {kernel_->clearLines(rows_.data(), columns_.data(), cells_.data(), width_, height_)};
+    if(cleared != 0){
+        unsigned lowest = MAXIMUM_HEIGHT - 1 - __builtin_clz(cleared);
+        for(unsigned y {0}; y <= lowest; ++y){
+            markDirty(y, fullRow_);
+            hash_ ^= Zobrist::row(y, before[y] ^ rows_[y]);
         }
     }
+    return cleared;
 }
 
-void Board::moveLine(unsigned y, int lineNb, Bric bricToAvoid){
-    for(unsigned u {0}; u < width_; ++u){
-        if(! checkCase(u, y)){
-            Position pos {Position(u, y)};
-            if(!bricToAvoid.contains(pos)){
-                Color temp {grid_.at(pos)};
-                swapCase(pos, Color());
-                pos = Position(pos.getX(),pos.getY()+lineNb);
-                swapCase(pos, temp);
-            }
-        }
+void Board::clearDirty(){
+    dirty_.fill(0);
+    dirtyRows_ = 0;
+}
+
+void Board::swapCase(Position &pos, Color color){
+    if(!contains(pos)){
+        throw std::out_of_range("la case est hors de la grille");
+    }
+    unsigned i {index(pos.getX(), pos.getY())};
+    Row bit {static_cast<Row>(1u << pos.getX())};
+    markDirty(pos.getY(), bit);
+    if(rows_[pos.getY()] & bit){
+        rows_[pos.getY()] &= ~bit;
+        columns_[pos.getX()] &= ~(Column(1) << pos.getY());
+        cells_[i] = 0;
+        hash_ ^= Zobrist::cell(pos.getX(), pos.getY());
+    } else if(!(color == Color())){
+        rows_[pos.getY()] |= bit;
+        columns_[pos.getX()] |= Column(1) << pos.getY();
+        cells_[i] = palette_.intern(color);
+        hash_ ^= Zobrist::cell(pos.getX(), pos.getY());
     }
 }
 
-unsigned Board::gridActualisation(unsigned lineNum){
-    unsigned lineCount {1};
-    LineState state;
-    EmptyRow(lineNum);
-    do {
-        --lineNum;
-        state = checkRow(lineNum);
-        if(state == LineState::FILL){
-            ++lineCount;
-            EmptyRow(lineNum);
-        } else{
-            moveLine(lineNum, lineCount);
+bool Board::addRows(const std::vector<Row> & rows, Color color){
+    const unsigned count {static_cast<unsigned>(std::min<std::size_t>(rows.size(), height_))};
+    if(count == 0){
+        return 1;
+    }
+    bool kept {1};
+    for(unsigned y {0}; y < count; ++y){
+        kept = kept && rows_[y] == 0;
+    }
+    const std::array<Row, MAXIMUM_HEIGHT> before {rows_};
+    const std::uint8_t grey {palette_.intern(color)};
+    std::copy(rows_.begin() + count, rows_.begin() + height_, rows_.begin());
+    std::copy(cells_.begin() + index(0, count), cells_.begin() + index(0, height_), cells_.begin());
+    for(unsigned x {0}; x < width_; ++x){
+        columns_[x] >>= count;
+    }
+    for(unsigned v {0}; v < count; ++v){
+        const unsigned y {height_ - count + v};
+        rows_[y] = rows[rows.size() - count + v] & fullRow_;
+        for(unsigned x {0}; x < width_; ++x){
+            const bool filled {static_cast<bool>((rows_[y] >> x) & 1u)};
+            columns_[x] |= Column(filled) << y;
+            cells_[index(x, y)] = filled ? grey : 0;
         }
-    } while(state != LineState::EMPTY && lineNum != 0);
-    return lineCount;
+    }
+    for(unsigned y {0}; y < height_; ++y){
+        markDirty(y, fullRow_);
+        hash_ ^= Zobrist::row(y, before[y] ^ rows_[y]);
+    }
+    return kept;
 }
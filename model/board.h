@@ -3,7 +3,13 @@
 
 #include "position.h"
 #include "color.h"
-#include <map>
+#include "palette.h"
+#include "row.h"
+#include "boardkernel.h"
+#include "zobrist.h"
+#include <array>
+#include <cstdint>
+#include <vector>
 
 /*!
  * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
@@ -11,17 +17,43 @@
 namespace GJ_GW{
 
 class Bric;
-enum class LineState;
 
 /*!
  * \brief Classe représentant la grille de jeu.
  *
  * Elle est composée de \ref Position et sa taille
  * est délimitée par sa largeur et sa hauteur.
+ *
+ * L'occupation de la grille est stockée sous forme de bitboard :
+ * chaque ligne est un mot machine (\ref Row) dont le bit n°x
+ * indique si la case d'abscisse x est pleine.
+ *
+ * Sa transposée (\ref Column) est tenue à jour à chaque modification,
+ * ce qui donne en temps constant la hauteur et le nombre de trous de
+ * chaque colonne.
+ *
+ * Les cases modifiées depuis la dernière notification des observateurs
+ * sont mémorisées ligne par ligne (\ref dirty_), ce qui permet aux vues
+ * de ne redessiner que ce qu'un coup a réellement changé.
+ *
+ * Les boucles critiques (lignes pleines, collisions, vidage) sont déléguées
+ * aux noyaux \ref BoardKernel spécialisés pour la taille de la grille.
+ *
+ * La clé de \ref Zobrist de l'occupation est tenue à jour en même temps que
+ * les lignes : deux grilles de même occupation ont la même clé.
  */
 class Board{
-    friend class Tetris;
+    friend class Simulation;
+    friend class MoveGenerator;
+
+public:
+    constexpr static unsigned MAXIMUM_WIDTH {16};
+    /*!< La largeur maximale d'une grille, le nombre de bits d'une \ref Row. */
 
+    constexpr static unsigned MAXIMUM_HEIGHT {32};
+    /*!< La hauteur maximale d'une grille, le nombre de bits d'une \ref Column. */
+
+private:
     unsigned width_;
     /*!< La largeur de la grille.
      *
@@ -34,28 +66,123 @@ class Board{
      * Cet attribut sert à construire la grille.
      */
 
-    std::map<Position, Color> grid_;
-    /*!< La grille de case.
+    const BoardKernel * kernel_;
+    /*!< Les noyaux de calcul spécialisés pour la taille de la grille.
+     *
+     * Ils sont choisis une fois pour toutes à la construction par \ref BoardKernel::select.
+     */
+
+    Row fullRow_;
+    /*!< Le masque d'une ligne pleine.
+     *
+     * Ses \ref width_ premiers bits valent 1.
+     */
+
+    std::array<Row, MAXIMUM_HEIGHT> rows_;
+    /*!< L'occupation des lignes de la grille.
+     *
+     * Une case est pleine si son bit vaut 1 et vide sinon.
+     */
+
+    std::array<Column, MAXIMUM_WIDTH> columns_;
+    /*!< L'occupation des colonnes de la grille.
+     *
+     * Elle contient les mêmes informations que \ref rows_, transposées.
+     */
+
+    std::array<Row, MAXIMUM_HEIGHT> dirty_;
+    /*!< Les cases modifiées depuis la dernière notification, ligne par ligne.
+     *
+     * Le bit n°x de la ligne y vaut 1 si la case (x, y) a changé.
+     */
+
+    Column dirtyRows_;
+    /*!< Le résumé de \ref dirty_ : le bit n°y vaut 1 si la ligne y a au moins une case modifiée. */
+
+    Palette palette_;
+    /*!< La table des couleurs utilisées dans la grille. */
+
+    std::array<std::uint8_t, MAXIMUM_WIDTH * MAXIMUM_HEIGHT> cells_;
+    /*!< Le plan de couleur des cases de la grille.
      *
-     * Elle est composée d'éléments dont les clés sont des \ref Position
-     * et qui peuvent être soit plein soit vide.
+     * Chaque case contient l'indice de sa couleur dans \ref palette_,
+     * les cases sont rangées ligne par ligne et une case vide vaut 0.
      */
 
+    std::uint64_t hash_;
+    /*!< La clé de \ref Zobrist des cases pleines de la grille. */
+
 public:
     /*!
      * \brief Constructeur de \ref Board.
      *
      * \param height la hauteur de la grille en nombre de cases.
      * \param width la largeur de la grille en nombre de cases.
+     * \throw std::invalid_argument si la largeur dépasse \ref MAXIMUM_WIDTH
+     * ou si la hauteur dépasse \ref MAXIMUM_HEIGHT
      */
     Board(unsigned width, unsigned height);
 
     /*!
-     * \brief Accesseur en lecture de la grille de jeu.
+     * \brief Accesseur en lecture de la couleur d'une case.
+     *
+     * La couleur est lue directement dans \ref cells_ et \ref palette_,
+     * sans copier la grille.
+     *
+     * \param x l'abscisse de la case, inférieure à la largeur de la grille
+     * \param y l'ordonnée de la case, inférieure à la hauteur de la grille
+     * \return la couleur de la case, blanche si elle est vide
+     */
+    inline Color getColor(unsigned x, unsigned y) const;
+
+    /*!
+     * \brief Méthode vérifiant si une case est pleine.
+     *
+     * \param x l'abscisse de la case, inférieure à la largeur de la grille
+     * \param y l'ordonnée de la case, inférieure à la hauteur de la grille
+     * \return true si la case est pleine, false sinon
+     */
+    inline bool isFilled(unsigned x, unsigned y) const;
+
+    /*!
+     * \brief Accesseur en lecture de l'occupation d'une ligne.
+     *
+     * \param y l'ordonnée de la ligne, inférieure à la hauteur de la grille
+     * \return le masque de la ligne, le bit n°x valant 1 si la case d'abscisse x est pleine
+     */
+    inline Row getRow(unsigned y) const;
+
+    /*!
+     * \brief Accesseur en lecture de l'occupation d'une colonne.
+     *
+     * \param x l'abscisse de la colonne, inférieure à la largeur de la grille
+     * \return le masque de la colonne, le bit n°y valant 1 si la case d'ordonnée y est pleine
+     */
+    inline Column getColumn(unsigned x) const;
+
+    /*!
+     * \brief Accesseur en lecture de la clé de \ref Zobrist de la grille.
+     *
+     * Elle ne dépend que des cases pleines, pas de leur couleur.
+     *
+     * \return le OU exclusif des clés des cases pleines
+     */
+    inline std::uint64_t getHash() const;
+
+    /*!
+     * \brief Accesseur en lecture des lignes modifiées depuis la dernière notification.
+     *
+     * \return le masque des lignes modifiées, le bit n°y représentant la ligne y
+     */
+    inline Column getDirtyRows() const;
+
+    /*!
+     * \brief Accesseur en lecture des cases d'une ligne modifiées depuis la dernière notification.
      *
-     * \return la grille de \ref Position et de \ref Color
+     * \param y l'ordonnée de la ligne, inférieure à la hauteur de la grille
+     * \return le masque des cases modifiées, le bit n°x représentant la case d'abscisse x
      */
-    std::map<Position, Color> getGrid() const;
+    inline Row getDirtyRow(unsigned y) const;
 
     /*!
      * \brief Accesseur en lecture de la hauteur de la grille.
@@ -71,108 +198,187 @@ public:
      */
     unsigned getWidth() const;
 
-private:
     /*!
-     * \brief Méthode vérifiant s'il y a des lignes pleines dans la grille de jeu.
+     * \brief Accesseur en lecture de la hauteur d'une colonne.
      *
-     * Dès que cette méthode trouve une ligne pleines, elle lance l'actualisation de la grille et
-     * renvoie le nombre de ligne pleine rencontrées lors de cette étape. Si elle n'en rencontre
-     * aucune elle renvoie 0.
+     * \param x l'abscisse de la colonne
+     * \return le nombre de lignes entre le bas de la grille et la plus haute case pleine
+     * de la colonne, incluse
+     */
+    unsigned getColumnHeight(unsigned x) const;
+
+    /*!
+     * \brief Accesseur en lecture du nombre de trous d'une colonne.
      *
-     * \param la ligne jusqu'à laquelle il faut effectuer les vérifications
-     * \return le nombre de lignes remplies
+     * Un trou est une case vide située sous la plus haute case pleine de la colonne.
+     *
+     * \param x l'abscisse de la colonne
+     * \return le nombre de trous de la colonne
      */
-    unsigned checkColumn(unsigned y = 0);
+    unsigned getColumnHoles(unsigned x) const;
 
     /*!
-     * \brief Méthode vérifiant si une case donnée est une destination valide pour un déplacement.
+     * \brief Méthode calculant de combien de lignes une \ref Bric posée dans la grille
+     * peut descendre.
      *
-     * Une case est valide si elle est incluse dans la grille de jeu et qu'elle est vide.
-     * Une case vide est de \ref Color blanche.
+     * Pour chaque case de la brique, le premier obstacle situé en dessous est trouvé
+     * directement dans \ref columns_, sans simuler la chute ligne par ligne.
      *
-     * \param pos la localisation de la position
-     * \return true si la case est valide, false sinon
+     * \param bric la brique, déjà posée dans la grille
+     * \return le nombre de déplacements vers le bas possibles
      */
-    bool checkCase(Position &pos) const;
+    unsigned dropDistance(const Bric & bric) const;
 
+private:
     /*!
-     * \brief Méthode changeant la couleur d'une case.
+     * \brief Méthode cherchant les lignes pleines de la grille de jeu.
      *
-     * Si elle passe à blanc, la case est considérée comme vide.
+     * Toutes les lignes sont comparées au masque d'une ligne pleine en une passe
+     * par le noyau \ref BoardKernel::fullRows.
      *
-     * \param pos la position à modifier
-     * \param color la couleur à appliquer
+     * \return le masque des lignes pleines, le bit n°y représentant la ligne y
      */
-    void swapCase(Position &pos, Color color);
+    Column getFullRows() const;
 
     /*!
-     * \brief Méthode qui actualise la grille de jeu.
+     * \brief Méthode vidant les lignes pleines de la grille de jeu.
      *
-     * L'actualisation de la grille vide les lignes remplies et ré-aligne les autres lignes de la grille.
+     * Les lignes restantes sont ré-alignées vers le bas par blocs de lignes
+     * consécutives, puis le haut de la grille est vidé.
      *
-     * \param lineNum le numéro de la première ligne remplie
-     * \return le nombre de lignes remplies traitées
+     * \return le masque des lignes vidées, le bit n°y représentant la ligne y
+     * avant l'actualisation
      */
-    unsigned gridActualisation(unsigned lineNum);
+    Column clearLines();
 
     /*!
-     * \brief Méthode vérifiant si la position donnée est incluse dans la grille de jeu.
+     * \brief Méthode vérifiant qu'une \ref Bric peut occuper une position donnée.
      *
-     * \param pos la localisation de la position
-     * \return true si la position est comprise dans la grille, false sinon
+     * Chaque ligne de l'orientation demandée est décalée et comparée par un ET
+     * binaire à la ligne correspondante de la grille, sans copier la brique,
+     * par le noyau \ref BoardKernel::fits.
+     *
+     * \param bric la brique à placer
+     * \param rotation l'indice de l'orientation de la brique à tester
+     * \param x l'abscisse du milieu de la brique à tester
+     * \param y l'ordonnée du milieu de la brique à tester
+     * \param placed vrai si la brique est déjà dans la grille, ses cases actuelles
+     * sont alors considérées comme vides
+     * \return true si toutes les cases de destination sont dans la grille et vides, false sinon
      */
-    bool contains(Position &pos) const;
+    bool checkBric(const Bric & bric, unsigned rotation, int x, int y, bool placed) const;
+
+    /*!
+     * \brief Méthode posant une \ref Bric dans la grille.
+     *
+     * Les cases de destination doivent être vides, ce qui est vérifié par \ref checkBric.
+     * La couleur de la brique doit déjà être dans \ref palette_ : les cases reçoivent
+     * l'indice qu'elle y a reçu au début de la partie.
+     *
+     * \param bric la brique à poser
+     */
+    void addBric(const Bric & bric);
 
     /*!
-     * \brief Méthode vérifiant si une case donnée est une destination valide pour un déplacement.
+     * \brief Méthode retirant une \ref Bric de la grille.
      *
-     * Une case est valide si elle est incluse dans la grille de jeu et qu'elle est vide.
-     * Une case vide est de \ref Color blanche.
+     * Les cases occupées par la brique redeviennent vides.
      *
-     * \param x l'abscisse de la \ref Position à vérifier
-     * \param y l'ordonnée de la \ref Position à vérifier
-     * \return true si la case est valide, false sinon
+     * \param bric la brique à retirer
      */
-    bool checkCase(unsigned & x, unsigned & y) const;
+    void removeBric(const Bric & bric);
 
     /*!
-     * \brief Méthode vérifiant l'état d'une ligne de la grille de jeu.
+     * \brief Méthode changeant la couleur d'une case.
      *
-     * Cette méthode vérifie si les \ref Position d'une ligne de la grille
-     * sont pleines ou non et renvoie son \ref LineState.
+     * Si elle passe à blanc, la case est considérée comme vide.
      *
-     * \param y le numéro de la ligne à vérifier
-     * \return l'état de la ligne
+     * \param pos la position à modifier
+     * \param color la couleur à appliquer
      */
-    LineState checkRow(unsigned &y) const;
+    void swapCase(Position &pos, Color color);
 
     /*!
-     * \brief Méthode vidant toutes les cases d'une ligne.
+     * \brief Méthode ajoutant des lignes au bas de la grille, en remontant tout son contenu.
      *
-     * Les cases de cette ligne prennent la \ref Color blanche.
+     * Les lignes, les colonnes et les couleurs sont décalées d'un bloc ; les cases
+     * qui sortent par le haut de la grille sont perdues.
      *
-     * \param y le numéro de la ligne à vider
+     * \param rows les cases pleines des lignes ajoutées, de la plus haute à la plus basse
+     * \param color la couleur des cases ajoutées
+     * \return true si aucune case pleine n'est sortie de la grille, false sinon
      */
-    void EmptyRow(unsigned y);
+    bool addRows(const std::vector<Row> & rows, Color color);
 
     /*!
-     * \brief Méthode descendant une ligne d'un nombre de cases donné.
+     * \brief Méthode vérifiant si la position donnée est incluse dans la grille de jeu.
      *
-     * \param y le numéro de la ligne à traiter
-     * \param lineNb le nombre de case que la ligne doit descendre
+     * \param pos la localisation de la position
+     * \return true si la position est comprise dans la grille, false sinon
      */
-    void moveLine(unsigned y, int lineNb);
+    bool contains(Position &pos) const;
 
     /*!
-     * \brief Méthode descendant une ligne d'un nombre de cases donné,
-     * en évitant de toucher à la brique donnée en paramètre.
+     * \brief Méthode marquant des cases d'une ligne comme modifiées.
      *
-     * \param y le numéro de la ligne à traiter
-     * \param lineNb le nombre de case que la ligne doit descendre
+     * \param y l'ordonnée de la ligne
+     * \param mask le masque des cases modifiées
+     */
+    inline void markDirty(unsigned y, Row mask);
+
+    /*!
+     * \brief Méthode oubliant les modifications, une fois les observateurs notifiés.
      */
-    void moveLine(unsigned y, int lineNb, Bric bricToAvoid);
+    void clearDirty();
+
+    /*!
+     * \brief Méthode calculant l'indice d'une case dans \ref cells_.
+     *
+     * \param x l'abscisse de la case
+     * \param y l'ordonnée de la case
+     * \return l'indice de la case
+     */
+    inline unsigned index(unsigned x, unsigned y) const;
 };
 
+//méthodes inline
+Color Board::getColor(unsigned x, unsigned y) const{
+    return palette_.getColor(cells_[index(x, y)]);
+}
+
+bool Board::isFilled(unsigned x, unsigned y) const{
+    return (rows_[y] >> x) & 1u;
+}
+
+Row Board::getRow(unsigned y) const{
+    return rows_[y];
+}
+
+Column Board::getColumn(unsigned x) const{
+    return columns_[x];
+}
+
+std::uint64_t Board::getHash() const{
+    return hash_;
+}
+
+Column Board::getDirtyRows() const{
+    return dirtyRows_;
+}
+
+Row Board::getDirtyRow(unsigned y) const{
+    return dirty_[y];
+}
+
+void Board::markDirty(unsigned y, Row mask){
+    dirty_[y] |= mask;
+    dirtyRows_ |= Column(mask != 0) << y;
+}
+
+unsigned Board::index(unsigned x, unsigned y) const{
+    return y * width_ + x;
+}
+
 } // namespace GJ_GW
 
 #endif // BOARD_H
@@ -0,0 +1,39 @@
+#include "boardkernel.h"
+#include <array>
+#include <utility>
+
+using namespace GJ_GW;
+
+namespace{
+
+constexpr unsigned WIDTHS {BoardKernel::MAXIMUM_WIDTH - BoardKernel::MINIMUM_WIDTH + 1};
+constexpr unsigned HEIGHTS {BoardKernel::MAXIMUM_HEIGHT - BoardKernel::MINIMUM_HEIGHT + 1};
+
+template<unsigned W, unsigned H>
+constexpr BoardKernel kernel(){
+    return BoardKernel{&FixedBoardKernel<W, H>::fullRows,
+                       &FixedBoardKernel<W, H>::fits,
+                       &FixedBoardKernel<W, H>::clearLines};
+}
+
+template<std::size_t... I>
+constexpr std::array<BoardKernel, sizeof...(I)> table(std::index_sequence<I...>){
+    return {{kernel<BoardKernel::MINIMUM_WIDTH + I / HEIGHTS,
+                    BoardKernel::MINIMUM_HEIGHT + I % HEIGHTS>()...}};
+}
+
+const std::array<BoardKernel, WIDTHS * HEIGHTS> KERNELS {table(std::make_index_sequence<WIDTHS * HEIGHTS>())};
+/*!< Les noyaux spécialisés, rangés par largeur puis par hauteur. */
+
+const BoardKernel GENERIC_KERNEL {kernel<0, 0>()};
+/*!< Les noyaux lisant la taille de la grille à l'exécution. */
+
+} // namespace
+
+const BoardKernel & BoardKernel::select(unsigned width, unsigned height){
+    if(width < MINIMUM_WIDTH || width > MAXIMUM_WIDTH
+            || height < MINIMUM_HEIGHT || height > MAXIMUM_HEIGHT){
+        return GENERIC_KERNEL;
+    }
+    return KERNELS[(width - MINIMUM_WIDTH) * HEIGHTS + height - MINIMUM_HEIGHT];
+}
@@ -0,0 +1,213 @@
+#ifndef BOARDKERNEL_H
+#define BOARDKERNEL_H
+
+#include "row.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure regroupant les noyaux de calcul du \ref Board pour une taille de grille.
+ *
+ * Chaque taille de grille acceptée par \ref Tetris dispose de sa propre
+ * instanciation de \ref FixedBoardKernel, choisie à l'exécution par \ref select
+ * lors de la construction du \ref Board.
+ */
+struct BoardKernel{
+    constexpr static unsigned MINIMUM_WIDTH {6};
+    /*!< La plus petite largeur disposant de noyaux spécialisés. */
+
+    constexpr static unsigned MAXIMUM_WIDTH {12};
+    /*!< La plus grande largeur disposant de noyaux spécialisés. */
+
+    constexpr static unsigned MINIMUM_HEIGHT {12};
+    /*!< La plus petite hauteur disposant de noyaux spécialisés. */
+
+    constexpr static unsigned MAXIMUM_HEIGHT {24};
+    /*!< La plus grande hauteur disposant de noyaux spécialisés. */
+
+    Column (*fullRows)(const Row * rows, unsigned width, unsigned height);
+    /*!< Le noyau cherchant les lignes pleines, voir \ref FixedBoardKernel::fullRows. */
+
+    bool (*fits)(const Row * rows, const Row * bricRows, unsigned bricWidth, unsigned bricHeight,
+                 int left, int top, const Row * ignored, unsigned width, unsigned height);
+    /*!< Le noyau de collision d'une brique, voir \ref FixedBoardKernel::fits. */
+
+    Column (*clearLines)(Row * rows, Column * columns, std::uint8_t * cells,
+                         unsigned width, unsigned height);
+    /*!< Le noyau vidant les lignes pleines, voir \ref FixedBoardKernel::clearLines. */
+
+    /*!
+     * \brief Méthode choisissant les noyaux correspondant à une taille de grille.
+     *
+     * Si la taille n'a pas d'instanciation spécialisée, les noyaux génériques,
+     * lisant la taille à l'exécution, sont renvoyés.
+     *
+     * \param width la largeur de la grille
+     * \param height la hauteur de la grille
+     * \return les noyaux de la grille
+     */
+    static const BoardKernel & select(unsigned width, unsigned height);
+};
+
+/*!
+ * \brief Classe implémentant les noyaux de calcul du \ref Board pour une taille fixée
+ * à la compilation.
+ *
+ * La largeur et la hauteur étant des constantes, le masque d'une ligne pleine est
+ * calculé à la compilation et les boucles sur les lignes et les colonnes peuvent être
+ * entièrement déroulées. L'instanciation FixedBoardKernel<0, 0> est la version
+ * générique, qui utilise la taille donnée à l'exécution.
+ *
+ * Les tableaux manipulés sont ceux du \ref Board : les lignes sont au nombre
+ * de bits d'une \ref Column et les couleurs sont rangées ligne par ligne.
+ */
+template<unsigned W, unsigned H>
+class FixedBoardKernel{
+    constexpr static unsigned ROWS {sizeof(Column) * 8};
+    /*!< Le nombre de lignes des tableaux du \ref Board. */
+
+    static_assert(W <= sizeof(Row) * 8 && H <= ROWS, "la grille dépasse la taille du bitboard");
+
+public:
+    /*!
+     * \brief Méthode cherchant les lignes pleines.
+     *
+     * Les lignes sont comparées au masque d'une ligne pleine huit à la fois
+     * lorsque le processeur dispose de SSE2.
+     *
+     * \param rows les lignes de la grille
+     * \param width la largeur de la grille, ignorée si W est non nul
+     * \param height la hauteur de la grille, ignorée si H est non nul
+     * \return le masque des lignes pleines, le bit n°y représentant la ligne y
+     */
+    static Column fullRows(const Row * rows, unsigned width, unsigned height){
+        const unsigned w {W ? W : width};
+        const unsigned h {H ? H : height};
+        const Row full {static_cast<Row>((1u << w) - 1)};
+        Column result {0};
+#ifdef __SSE2__
+        const __m128i mask {_mm_set1_epi16(static_cast<short>(full))};
+        for(unsigned y {0}; y < h; y += 16){
+            __m128i high {_mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(rows + y)), mask)};
+            __m128i low {_mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(rows + y + 8)), mask)};
+            result |= static_cast<Column>(_mm_movemask_epi8(_mm_packs_epi16(high, low))) << y;
+        }
+#else
+        for(unsigned y {0}; y < h; ++y){
+            result |= static_cast<Column>(rows[y] == full) << y;
+        }
+#endif
+        return (h < ROWS)? result & ((Column(1) << h) - 1) : result;
+    }
+
+    /*!
+     * \brief Méthode vérifiant qu'une brique peut occuper une position.
+     *
+     * \param rows les lignes de la grille
+     * \param bricRows les masques des lignes du cadre de la brique
+     * \param bricWidth la largeur du cadre de la brique
+     * \param bricHeight la hauteur du cadre de la brique
+     * \param left l'abscisse du cadre dans la grille
+     * \param top l'ordonnée du cadre dans la grille
+     * \param ignored pour chaque ligne du cadre, les cases de la grille à considérer comme vides
+     * \param width la largeur de la grille, ignorée si W est non nul
+     * \param height la hauteur de la grille, ignorée si H est non nul
+     * \return true si le cadre est dans la grille et que ses cases sont vides, false sinon
+     */
+    static bool fits(const Row * rows, const Row * bricRows, unsigned bricWidth, unsigned bricHeight,
+                     int left, int top, const Row * ignored, unsigned width, unsigned height){
+        const int w {static_cast<int>(W ? W : width)};
+        const int h {static_cast<int>(H ? H : height)};
+        if(left < 0 || top < 0 || left + static_cast<int>(bricWidth) > w
+                || top + static_cast<int>(bricHeight) > h){
+            return false;
+        }
+        Row collisions {0};
+        for(unsigned v {0}; v < bricHeight; ++v){
+            collisions |= (bricRows[v] << left) & rows[top + v] & ~ignored[v];
+        }
+        return collisions == 0;
+    }
+
+    /*!
+     * \brief Méthode vidant les lignes pleines.
+     *
+     * Chaque bloc de lignes restantes consécutives est déplacé vers le bas
+     * en une seule copie, puis le haut de la grille est vidé.
+     *
+     * \param rows les lignes de la grille
+     * \param columns les colonnes de la grille
+     * \param cells les indices de couleur des cases de la grille
+     * \param width la largeur de la grille, ignorée si W est non nul
+     * \param height la hauteur de la grille, ignorée si H est non nul
+     * \return le masque des lignes vidées, le bit n°y représentant la ligne y
+     * avant l'actualisation
+     */
+    static Column clearLines(Row * rows, Column * columns, std::uint8_t * cells,
+                             unsigned width, unsigned height){
+        const unsigned w {W ? W : width};
+        const unsigned h {H ? H : height};
+        Column cleared {fullRows(rows, w, h)};
+        if(cleared == 0){
+            return 0;
+        }
+        unsigned end {h};
+        unsigned dst {h};
+        Column remaining {cleared};
+        while(remaining != 0){
+            unsigned y = ROWS - 1 - __builtin_clz(remaining);
+            remaining &= ~(Column(1) << y);
+            moveRows(rows, cells, w, y + 1, end, dst);
+            dst -= end - (y + 1);
+            end = y;
+        }
+        moveRows(rows, cells, w, 0, end, dst);
+        dst -= end;
+        std::fill_n(rows, dst, 0);
+        std::fill_n(cells, dst * w, 0);
+        for(unsigned u {0}; u < w; ++u){
+            Column column {columns[u]};
+            for(remaining = cleared; remaining != 0; remaining &= remaining - 1){
+                unsigned y = __builtin_ctz(remaining);
+                Column above {(Column(1) << y) - 1};
+                column = ((column & above) << 1) | (column & ~(above | (Column(1) << y)));
+            }
+            columns[u] = column;
+        }
+        return cleared;
+    }
+
+private:
+    /*!
+     * \brief Méthode déplaçant un bloc de lignes consécutives vers le bas.
+     *
+     * \param rows les lignes de la grille
+     * \param cells les indices de couleur des cases de la grille
+     * \param w la largeur de la grille
+     * \param begin la première ligne du bloc
+     * \param end la ligne suivant la dernière ligne du bloc
+     * \param dst la ligne suivant la dernière ligne de la destination
+     */
+    static void moveRows(Row * rows, std::uint8_t * cells, unsigned w,
+                         unsigned begin, unsigned end, unsigned dst){
+        unsigned count {end - begin};
+        if(count == 0 || dst == end){
+            return;
+        }
+        std::memmove(rows + dst - count, rows + begin, count * sizeof(Row));
+        std::memmove(cells + (dst - count) * w, cells + begin * w, count * w);
+    }
+};
+
+} // namespace GJ_GW
+
+#endif // BOARDKERNEL_H
@@ -2,24 +2,34 @@
 #include "direction.h"
 #include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 using namespace GJ_GW;
 
+static_assert(std::is_trivially_copyable<Bric>::value, "une Bric doit rester copiable sans allocation");
+
 Bric::Bric(){
     side_ = 0;
+    paletteIndex_ = 0;
+    orientations_.fill(Orientation{{}, 0, 0, 0, 0});
+    rotation_ = 0;
 }
 
-Bric::Bric(std::vector<Position> &shape, Color color):shape_{validateShape(shape)}{
-    side_ = validateSide().at(0);
+Bric::Bric(std::vector<Position> &shape, Color color){
+    std::vector<Position> cells {validateShape(shape)};
+    std::vector<unsigned> sides {validateSide(cells)};
+    side_ = sides.at(0);
     if(side_ % 2 == 0){
         middle_ = Position((side_/2)-1, (side_/2)-1);
     } else{
         middle_ = Position(side_/2, side_/2);
     }
-    if(validateSide().at(1) == 1 && side_ > 1){
+    if(sides.at(1) == 1 && side_ > 1){
         middle_.setY(-1);
     }
     color_ = color;
+    paletteIndex_ = 0;
+    computeOrientations(cells);
 }
 
 unsigned Bric::calculateSideSize(std::vector<unsigned> side){
@@ -28,18 +38,18 @@ unsigned Bric::calculateSideSize(std::vector<unsigned> side){
     return side.size();
 }
 
-std::vector<unsigned> Bric::validateSide(){
+std::vector<unsigned> Bric::validateSide(std::vector<Position> &shape){
     std::vector<unsigned> tempX;
     std::vector<unsigned> tempY;
     unsigned sideX;
     unsigned sideY;
-    for(Position p : shape_){
+    for(Position p : shape){
         tempX.push_back((p.x_));
         tempY.push_back(p.y_);
     }
     std::sort(tempX.begin(), tempX.end());
     if(tempX.at(0) != 0){
-        adjustPositions(tempX.at(0));
+        adjustPositions(shape, tempX.at(0));
     }
     sideX = calculateSideSize(tempX);
     sideY = calculateSideSize(tempY);
@@ -79,9 +89,9 @@ bool Bric::isAdjacent(std::vector<Position> &tested, Position &pos){
     return ok;
 }
 
-void Bric::adjustPositions(unsigned xMin){
-    for(unsigned u {0}; u < shape_.size(); ++u){
-        shape_.at(u).setX(-xMin);
+void Bric::adjustPositions(std::vector<Position> &shape, unsigned xMin){
+    for(unsigned u {0}; u < shape.size(); ++u){
+        shape.at(u).setX(-xMin);
     }
 }
 
@@ -98,62 +108,69 @@ Color Bric::getColor() const{
     return color_;
 }
 
-unsigned Bric::getHigherY(){
-    Position temp {shape_.at(0)};
-    for(Position p : shape_){
-        if(temp > p)
-            temp = p;
-    }
-    return temp.y_;
+unsigned Bric::getHigherY() const{
+    return middle_.y_ + orientations_[rotation_].top;
 }
 
 void Bric::move(Direction dir){
     switch(dir){
     case Direction::LEFT:
-        for(unsigned u = 0; u < shape_.size(); ++u){
-            shape_.at(u).setX(-1);
-        }
         middle_.setX(-1);
         break;
     case Direction::RIGHT:
-        for(unsigned u = 0; u < shape_.size(); ++u){
-            shape_.at(u).setX(1);
-        }
         middle_.setX(1);
         break;
     case Direction::UP:
-        for(unsigned u = 0; u < shape_.size(); ++u){
-            shape_.at(u).setY(-1);
-        }
         middle_.setY(-1);
         break;
     case Direction::DOWN:
-        for(unsigned u = 0; u < shape_.size(); ++u){
-            shape_.at(u).setY(1);
-        }
         middle_.setY(1);
         break;
     }
 }
 
 void Bric::rotate(){
-    double midX = middle_.x_, midY = middle_.y_;
-    if(side_%2 == 0){
-        midX += 0.5;
-        midY += 0.5;
+    rotation_ = (rotation_ + 1) % ORIENTATIONS;
+}
+
+void Bric::computeOrientations(const std::vector<Position> &shape){
+    std::vector<int> dx;
+    std::vector<int> dy;
+    for(Position p : shape){
+        dx.push_back(static_cast<int>(p.x_ - middle_.x_));
+        dy.push_back(static_cast<int>(p.y_ - middle_.y_));
     }
-    for(unsigned u {0}; u < shape_.size(); ++u){
-        shape_.at(u) = Position (midX - shape_.at(u).getY() + midY,
-                                 midY + shape_.at(u).getX() - midX);
+    int shift {(side_ % 2 == 0)? 1 : 0};    // un carré de côté pair tourne autour du coin du milieu
+    for(Orientation & o : orientations_){
+        o.left = *std::min_element(dx.begin(), dx.end());
+        o.top = *std::min_element(dy.begin(), dy.end());
+        o.width = *std::max_element(dx.begin(), dx.end()) - o.left + 1;
+        o.height = *std::max_element(dy.begin(), dy.end()) - o.top + 1;
+        o.rows.fill(0);
+        for(unsigned u {0}; u < dx.size(); ++u){
+            o.rows[dy[u] - o.top] |= 1u << (dx[u] - o.left);
+            int x {dx[u]};
+            dx[u] = shift - dy[u];
+            dy[u] = x;
+        }
     }
+    rotation_ = 0;
 }
 
-bool Bric::contains(Position & pos) const{
-    bool ok {0};
-    for(Position p : shape_){
-        if(p == pos){
-            ok = 1;
-        }
+Row Bric::getRowMask(int y) const{
+    const Orientation & o {orientations_[rotation_]};
+    int v {y - (static_cast<int>(middle_.y_) + o.top)};
+    if(v < 0 || v >= static_cast<int>(o.height)){
+        return 0;
     }
-    return ok;
+    int left {static_cast<int>(middle_.x_) + o.left};
+    return (left < 0)? o.rows[v] >> -left : static_cast<Row>(o.rows[v] << left);
+}
+
+bool Bric::contains(Position & pos) const{
+    const Orientation & o {orientations_[rotation_]};
+    int u {static_cast<int>(pos.x_) - (static_cast<int>(middle_.x_) + o.left)};
+    int v {static_cast<int>(pos.y_) - (static_cast<int>(middle_.y_) + o.top)};
+    return u >= 0 && v >= 0 && u < static_cast<int>(o.width) && v < static_cast<int>(o.height)
+            && ((o.rows[v] >> u) & 1u);
 }
@@ -3,6 +3,9 @@
 
 #include "position.h"
 #include "color.h"
+#include "row.h"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -16,24 +19,58 @@ enum class Direction;
 /*!
  * \brief Classe représentant une brique de Tetris.
  *
- * La forme de la brique est représentée par un ensemble de \ref Position,
+ * La forme de la brique est donnée par un ensemble de \ref Position,
  * elle possède une \ref Color, un milieu et une taille de côté.
+ *
+ * Ses quatre orientations sont calculées une seule fois à la construction,
+ * sous forme de masques de bits par ligne, ce qui permet au \ref Board de
+ * tester un déplacement ou une rotation sans copier la brique.
+ *
+ * Ces masques sont stockés dans la brique elle-même : une \ref Bric est
+ * trivialement copiable et sa copie ne sollicite jamais l'allocateur.
  */
 class Bric{
-    friend class Tetris;
+    friend class Simulation;
+    friend class Board;
+    friend class MoveGenerator;
+    friend class Replay;
 
     constexpr static unsigned MAXIMUM_SIDE {6};
     /*!< La taille de côté maximum d'une brique. */
 
-    std::vector<Position> shape_;
-    /*!< La forme de la brique.
+    constexpr static unsigned ORIENTATIONS {4};
+    /*!< Le nombre d'orientations d'une brique. */
+
+    /*!
+     * \brief Structure représentant une orientation précalculée de la \ref Bric.
      *
-     * Représente l'ensemble des cases qui sont remplies par la brique.
+     * Les cases de l'orientation sont décrites par un masque par ligne de
+     * leur cadre englobant, lui-même placé relativement au milieu de la brique.
      */
+    struct Orientation{
+        std::array<Row, MAXIMUM_SIDE> rows;
+        /*!< Les masques des lignes du cadre, le bit n°0 représentant sa colonne de gauche. */
+
+        int left;
+        /*!< L'abscisse du cadre relativement au milieu de la brique. */
+
+        int top;
+        /*!< L'ordonnée du cadre relativement au milieu de la brique. */
+
+        unsigned width;
+        /*!< La largeur du cadre. */
+
+        unsigned height;
+        /*!< La hauteur du cadre. */
+    };
 
     Color color_;
     /*!< La couleur de la brique. */
 
+    std::uint8_t paletteIndex_;
+    /*!< L'indice de la couleur dans la palette de la grille, fixé par la
+     * \ref Simulation au début de la partie. */
+
     Position middle_;
     /*!< Le point central du carré entourant la brique. */
 
@@ -44,6 +81,15 @@ class Bric{
      * du côté le plus grand de la brique.
      */
 
+    std::array<Orientation, ORIENTATIONS> orientations_;
+    /*!< Les orientations de la brique, la n°i étant obtenue après i rotations.
+     *
+     * Représentent l'ensemble des cases qui sont remplies par la brique.
+     */
+
+    unsigned rotation_;
+    /*!< L'indice de l'orientation courante de la brique. */
+
 public:
     /*!
      * \brief Constructeur sans argument de \ref Bric.
@@ -95,9 +141,10 @@ private:
      * \brief Méthode calculant, à partir de la forme d'une \ref Bric,
      * sa taille de côté et vérifiant que la brique est positionnée
      * horizontalement.
+     * \param shape la forme de la brique, recadrée si nécessaire
      * \return les tailles de côté de la brique
      */
-    std::vector<unsigned> validateSide();
+    static std::vector<unsigned> validateSide(std::vector<Position> &shape);
 
     /*!
      * \brief Méthode vérifiant si une forme de \ref Bric est valide.
@@ -116,9 +163,10 @@ private:
 
     /*!
      * \brief Méthode permettant de recadrer une forme de \ref Bric mal positionnée.
+     * \param shape la forme à recadrer
      * \param xMin l'abscisse de la \ref Position la plus à gauche de la forme
      */
-    void adjustPositions(unsigned xMin);
+    static void adjustPositions(std::vector<Position> &shape, unsigned xMin);
 
     /*!
      * \brief Méthode qui vérifie si les cases d'une \ref Bric sont adjacentes
@@ -141,16 +189,32 @@ private:
      * \brief Méthode trouvant l'ordonnée de la \ref Position la plus haute de la brique.
      * \return l'ordonnée du point le plus haut de la brique
      */
-    unsigned getHigherY();
+    unsigned getHigherY() const;
 
     /*!
      * \brief Méthode qui tourne la \ref Bric.
      *
      * Si l'on imagine la brique comme étant dans un carré de case :
      * tourne les \ref Position des cases de ce carrée de 90°.
+     * Seul l'indice de l'orientation courante change.
      */
     void rotate();
 
+    /*!
+     * \brief Méthode calculant les \ref ORIENTATIONS de la \ref Bric
+     * à partir de sa forme et de son milieu.
+     * \param shape la forme validée de la brique
+     */
+    void computeOrientations(const std::vector<Position> &shape);
+
+    /*!
+     * \brief Méthode renvoyant les cases occupées par la \ref Bric sur une ligne de la grille.
+     *
+     * \param y l'ordonnée de la ligne
+     * \return le masque des cases de la ligne occupées par la brique
+     */
+    Row getRowMask(int y) const;
+
     /*!
      * \brief Méthode déplaçant la \ref Bric dans une \ref Direction.
      * \param dir la direction choisie
@@ -1,10 +1,11 @@
 #include "bricsBag.h"
 #include <algorithm>
-#include <chrono>
+#include <stdexcept>
 
 using namespace GJ_GW;
 
-BricsBag::BricsBag(){
+BricsBag::BricsBag(): policy_{BagPolicy::SWAP_SHUFFLE}, seed_{0},
+    head_{0}, count_{0}, depth_{1}, historySize_{0}, remainingSize_{0}{
     std::vector<Position> shapeI {Position(0,0),Position(1,0),Position(2,0),Position(3,0)};
     std::vector<Position> shapeO {Position(0,0),Position(1,0),Position(0,1),Position(1,1)};
     std::vector<Position> shapeT {Position(1,0),Position(1,1),Position(0,1),Position(2,1)};
@@ -12,53 +13,145 @@ BricsBag::BricsBag(){
     std::vector<Position> shapeJ {Position(0,0),Position(0,1),Position(1,1),Position(2,1)};
     std::vector<Position> shapeZ {Position(0,0),Position(1,0),Position(1,1),Position(2,1)};
     std::vector<Position> shapeS {Position(2,0),Position(1,0),Position(1,1),Position(0,1)};
-    std::vector<unsigned> colorI{130,180,190};
-    std::vector<unsigned> colorO{255,215,0};
-    std::vector<unsigned> colorT{50,50,160};
-    std::vector<unsigned> colorL{220,120,30};
-    std::vector<unsigned> colorJ{150,0,255};
-    std::vector<unsigned> colorZ{150,20,30};
-    std::vector<unsigned> colorS{150,200,7};
-    brics_.push_back(Bric(shapeI, Color(colorI)));
-    brics_.push_back(Bric(shapeO, Color(colorO)));
-    brics_.push_back(Bric(shapeT, Color(colorT)));
-    brics_.push_back(Bric(shapeL, Color(colorL)));
-    brics_.push_back(Bric(shapeJ, Color(colorJ)));
-    brics_.push_back(Bric(shapeZ, Color(colorZ)));
-    brics_.push_back(Bric(shapeS, Color(colorS)));
+    brics_.push_back(Bric(shapeI, Color(130,180,190)));
+    brics_.push_back(Bric(shapeO, Color(255,215,0)));
+    brics_.push_back(Bric(shapeT, Color(50,50,160)));
+    brics_.push_back(Bric(shapeL, Color(220,120,30)));
+    brics_.push_back(Bric(shapeJ, Color(150,0,255)));
+    brics_.push_back(Bric(shapeZ, Color(150,20,30)));
+    brics_.push_back(Bric(shapeS, Color(150,200,7)));
+    shuffle(true);
 }
 
-BricsBag::BricsBag(std::vector<Bric> & brics): brics_ {brics}
-{}
+BricsBag::BricsBag(std::vector<Bric> & brics): brics_ {brics},
+    policy_{BagPolicy::SWAP_SHUFFLE}, seed_{0}, head_{0}, count_{0}, depth_{1}, historySize_{0},
+    remainingSize_{0}{
+    if(brics_.size() > MAXIMUM_BRICS){
+        throw std::length_error("le sac ne peut contenir plus de "+ std::to_string(MAXIMUM_BRICS) +" briques");
+    }
+    shuffle(true);
+}
+
+const Bric & BricsBag::getNextBric() const{
+    return brics_.at(queue_[(head_ + 1) & (QUEUE_SIZE - 1)]);
+}
 
-Bric BricsBag::getNextBric() const{
-    if(brics_.size() == 1){
-        return brics_.at(0);
+const Bric & BricsBag::getCurrentBric() const{
+    return brics_.at(queue_[head_]);
+}
+
+const Bric & BricsBag::getPreview(unsigned index) const{
+    if(index >= depth_){
+        throw std::out_of_range("la brique demandée n'est pas visible");
     }
-    return brics_.at(1);
+    return brics_.at(queue_[(head_ + 1 + index) & (QUEUE_SIZE - 1)]);
 }
 
-Bric BricsBag::getCurrentBric() const{
-    return brics_.at(0);
+void BricsBag::setPreviewDepth(unsigned depth){
+    if(depth == 0 || depth > MAXIMUM_PREVIEW){
+        throw std::invalid_argument("le nombre de briques visibles doit être compris entre 1 et "
+                                    + std::to_string(MAXIMUM_PREVIEW));
+    }
+    depth_ = depth;
+    while(!brics_.empty() && count_ < depth_ + 1){
+        push();
+    }
 }
 
 void BricsBag::add(std::vector<Bric> & newBrics){
+    if(brics_.size() + newBrics.size() > MAXIMUM_BRICS){
+        throw std::length_error("le sac ne peut contenir plus de "+ std::to_string(MAXIMUM_BRICS) +" briques");
+    }
     for(Bric b : newBrics){
         brics_.push_back(b);
     }
 }
 
 void BricsBag::shuffle(bool first){
-    if(brics_.size() > 2){
-        unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-        if(first){
-            std::shuffle(brics_.begin(), brics_.end(), std::default_random_engine(seed));
-        } else{
-            std::swap(brics_.at(0), brics_.at(brics_.size()-1));
-            std::swap(brics_.at(0), brics_.at(1));
-            std::random_shuffle(++brics_.begin(), --brics_.end());
+    if(brics_.empty()){
+        return;
+    }
+    if(first){
+        random_.seed(seed_);
+        head_ = 0;
+        count_ = 0;
+        historySize_ = 0;
+        remainingSize_ = 0;
+    } else if(count_ != 0){
+        head_ = (head_ + 1) & (QUEUE_SIZE - 1);
+        --count_;
+    }
+    while(count_ < depth_ + 1){
+        push();
+    }
+}
+
+void BricsBag::push(){
+    unsigned index {draw()};
+    queue_[(head_ + count_) & (QUEUE_SIZE - 1)] = index;
+    ++count_;
+    for(unsigned u {HISTORY_SIZE - 1}; u > 0; --u){
+        history_[u] = history_[u - 1];
+    }
+    history_[0] = index;
+    if(historySize_ < HISTORY_SIZE){
+        ++historySize_;
+    }
+}
+
+void BricsBag::setSeed(std::uint64_t seed){
+    seed_ = seed;
+}
+
+void BricsBag::setPolicy(BagPolicy policy){
+    policy_ = policy;
+}
+
+unsigned BricsBag::draw(){
+    unsigned size = brics_.size();
+    switch(policy_){
+    case BagPolicy::SEVEN_BAG:
+        if(remainingSize_ == 0){
+            for(unsigned u {0}; u < size; ++u){
+                remaining_[u] = size - 1 - u;
+            }
+            for(unsigned u {size - 1}; u > 0; --u){
+                std::swap(remaining_[u], remaining_[random_.below(u + 1)]);
+            }
+            remainingSize_ = size;
         }
-    } else if(brics_.size() == 2){
-        std::swap(brics_.at(0),brics_.at(1));
+        return remaining_[--remainingSize_];
+    case BagPolicy::HISTORY:
+        {
+            auto end = history_.begin() + historySize_;
+            unsigned index {random_.below(size)};
+            for(unsigned u {0}; u < HISTORY_ROLLS && std::find(history_.begin(), end, index) != end; ++u){
+                index = random_.below(size);
+            }
+            return index;
+        }
+    case BagPolicy::SWAP_SHUFFLE:
+    default:
+        return drawExcluding(std::min<unsigned>(2, size - 1));
+    }
+}
+
+unsigned BricsBag::drawExcluding(unsigned excluded){
+    excluded = std::min(excluded, historySize_);
+    if(excluded == 2 && history_[0] == history_[1]){
+        excluded = 1;
+    }
+    unsigned low {history_[0]};
+    unsigned high {history_[excluded == 2 ? 1 : 0]};
+    if(low > high){
+        std::swap(low, high);
+    }
+    unsigned index {random_.below(brics_.size() - excluded)};
+    if(excluded > 0 && index >= low){
+        ++index;
+    }
+    if(excluded > 1 && index >= high){
+        ++index;
     }
+    return index;
 }
@@ -2,6 +2,11 @@
 #define BRICSBAG_H
 
 #include "bric.h"
+#include "bagpolicy.h"
+#include "random.h"
+#include <array>
+#include <cstdint>
+#include <vector>
 
 /*!
  * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
@@ -10,15 +15,85 @@ namespace GJ_GW{
 
 /*!
  * \brief Classe représentant le sac de briques du joueur.
+ *
+ * Les briques sont tirées par un générateur \ref Random selon une \ref BagPolicy.
+ * La suite des briques ne dépend que de la graine, de la politique et du contenu
+ * du sac : deux sacs identiques de même graine distribuent les mêmes briques.
+ *
+ * Les briques à venir sont rangées par indice dans une file circulaire de taille
+ * fixe, complétée au fur et à mesure : une mise en jeu ne déplace aucune brique,
+ * quelle que soit la taille du sac.
  */
 class BricsBag{
-    friend class Tetris;
+    friend class Simulation;
+
+public:
+    constexpr static unsigned MAXIMUM_PREVIEW {6};
+    /*!< Le nombre maximal de briques à venir visibles après la brique courante. */
+
+    constexpr static unsigned HISTORY_SIZE {4};
+    /*!< Le nombre de dernières briques évitées par \ref BagPolicy::HISTORY. */
+
+    constexpr static unsigned HISTORY_ROLLS {6};
+    /*!< Le nombre maximal de nouveaux tirages de \ref BagPolicy::HISTORY pour éviter
+     * l'historique, après le 1er tirage. */
+
+    constexpr static unsigned MAXIMUM_BRICS {64};
+    /*!< Le nombre maximal de briques d'un sac. */
+
+private:
     std::vector<Bric> brics_;
     /*!< Les briques contenues dans le sac.
      *
      * Représente l'ensemble des briques utilisables en jeu.
      */
 
+    BagPolicy policy_;
+    /*!< La manière de tirer les briques. */
+
+    std::uint64_t seed_;
+    /*!< La graine du générateur, ré-appliquée au début de chaque partie. */
+
+    Random random_;
+    /*!< Le générateur des tirages. */
+
+    constexpr static unsigned QUEUE_SIZE {8};
+    /*!< La capacité de \ref queue_, une puissance de 2 supérieure à \ref MAXIMUM_PREVIEW. */
+
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0 && QUEUE_SIZE > MAXIMUM_PREVIEW,
+                  "la file doit contenir la brique courante et toutes les briques visibles");
+
+    std::array<unsigned, QUEUE_SIZE> queue_;
+    /*!< La file circulaire des indices dans \ref brics_ des briques tirées et pas encore jouées.
+     *
+     * La brique courante est à l'indice \ref head_.
+     */
+
+    unsigned head_;
+    /*!< La position de la brique courante dans \ref queue_. */
+
+    unsigned count_;
+    /*!< Le nombre de briques dans \ref queue_. */
+
+    unsigned depth_;
+    /*!< Le nombre de briques visibles après la brique courante. */
+
+    std::array<unsigned, HISTORY_SIZE> history_;
+    /*!< Les indices des dernières briques tirées, de la plus récente à la plus ancienne. */
+
+    unsigned historySize_;
+    /*!< Le nombre d'indices valides dans \ref history_. */
+
+    std::array<std::uint8_t, MAXIMUM_BRICS> remaining_;
+    /*!< Les indices des briques restant à distribuer par \ref BagPolicy::SEVEN_BAG,
+     * la prochaine brique étant la dernière.
+     *
+     * Sa taille fixe permet de sauvegarder l'état du sac par une simple copie.
+     */
+
+    unsigned remainingSize_;
+    /*!< Le nombre d'indices valides dans \ref remaining_. */
+
 public:
     /*!
      * \brief Constructeur sans argument de \ref BricsBag.
@@ -31,6 +106,7 @@ public:
      * \brief Constructeur de \ref BricsBag.
      *
      * \param brics les briques du sac
+     * \throw std::length_error si le sac contient plus de \ref MAXIMUM_BRICS briques
      */
     explicit BricsBag(std::vector<Bric> &brics);
 
@@ -38,6 +114,7 @@ private:
     /*!
      * \brief Méthode ajoutant de nouvelles \ref Bric au \ref BricsBag.
      * \param newBrics les nouvelles briques
+     * \throw std::length_error si le sac dépasse \ref MAXIMUM_BRICS briques
      */
     void add(std::vector<Bric> &newBrics);
 
@@ -45,23 +122,84 @@ private:
      * \brief Accesseur en lecture de la \ref Bric courante.
      * \return la brique au sommet du sac
      */
-    Bric getCurrentBric() const;
+    const Bric & getCurrentBric() const;
 
     /*!
      * \brief Accesseur en lecture de la prochaine \ref Bric courante.
      * \return la seconde brique du sac.
      */
-    Bric getNextBric() const;
+    const Bric & getNextBric() const;
 
     /*!
-     * \brief Méthode mélangeant les \ref Bric dans le sac.
+     * \brief Accesseur en lecture d'une \ref Bric à venir.
      *
-     * Si c'est la 1ère fois qu'elle est appelée, elle mélange toutes
-     * les briques du sac.
-     * Sinon elle place l'ancienne brique courante au début du sac
-     * et la nouvelle à la fin, puis mélange les autres briques du sac.
+     * \param index le rang de la brique après la brique courante, 0 désignant la prochaine
+     * \return la brique à venir
+     * \throw std::out_of_range si le rang n'est pas inférieur à \ref depth_
+     */
+    const Bric & getPreview(unsigned index) const;
+
+    /*!
+     * \brief Accesseur en écriture du nombre de briques visibles après la brique courante.
+     *
+     * La suite des briques ne dépend pas de ce nombre.
+     *
+     * \param depth le nombre de briques visibles
+     * \throw std::invalid_argument si le nombre n'est pas compris entre 1 et \ref MAXIMUM_PREVIEW
+     */
+    void setPreviewDepth(unsigned depth);
+
+    /*!
+     * \brief Méthode mettant en jeu la prochaine \ref Bric du sac.
+     *
+     * Si c'est la 1ère fois qu'elle est appelée pour une partie, le générateur
+     * est ré-initialisé avec \ref seed_ et la file est vidée. Sinon la prochaine
+     * brique devient la brique courante, en temps constant. La file est ensuite
+     * complétée jusqu'à contenir la brique courante et \ref depth_ briques visibles.
+     *
+     * \param first indique s'il s'agit du 1er tirage de la partie
      */
     void shuffle(bool first);
+
+    /*!
+     * \brief Méthode tirant une brique à la fin de la file.
+     */
+    void push();
+
+    /*!
+     * \brief Accesseur en écriture de la graine.
+     *
+     * Elle est appliquée au prochain 1er tirage d'une partie.
+     *
+     * \param seed la graine
+     */
+    void setSeed(std::uint64_t seed);
+
+    /*!
+     * \brief Accesseur en écriture de la manière de tirer les briques.
+     *
+     * Elle s'applique dès le prochain tirage.
+     *
+     * \param policy la politique de tirage
+     */
+    void setPolicy(BagPolicy policy);
+
+    /*!
+     * \brief Méthode tirant l'indice d'une brique selon \ref policy_.
+     * \return l'indice dans \ref brics_ de la brique tirée
+     */
+    unsigned draw();
+
+    /*!
+     * \brief Méthode tirant uniformément une brique différente des deux plus récentes de l'historique.
+     *
+     * Le rang tiré parmi les briques permises est décalé au-delà des briques évitées,
+     * sans parcourir le sac.
+     *
+     * \param excluded le nombre de briques de l'historique à éviter, au plus 2
+     * \return l'indice dans \ref brics_ de la brique tirée
+     */
+    unsigned drawExcluding(unsigned excluded);
 };
 
 } // namespace GJ_GW
@@ -2,12 +2,9 @@
 
 using namespace GJ_GW;
 
-Color::Color(): code_{255, 255, 255}
+Color::Color(): Color(255, 255, 255)
 {}
 
-Color::Color(std::vector<unsigned> &code): code_{code}
+Color::Color(unsigned red, unsigned green, unsigned blue):
+    code_{((red & 0xFFu) << 16) | ((green & 0xFFu) << 8) | (blue & 0xFFu)}
 {}
-
-std::vector<unsigned> Color::getCode() const{
-    return code_;
-}
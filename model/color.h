@@ -1,7 +1,7 @@
 #ifndef COLOR_H
 #define COLOR_H
 
-#include <vector>
+#include <cstdint>
 
 /*!
  * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
@@ -10,14 +10,17 @@ namespace GJ_GW{
 
 /*!
  * \brief Classe représentant la couleur d'une case de la grille.
+ *
+ * La couleur est compactée dans un entier de 32 bits, elle est donc
+ * trivialement copiable et sa comparaison ne coûte qu'une instruction.
  */
 class Color{
-    std::vector<unsigned> code_;
+    std::uint32_t code_;
     /*!< le code couleur RGB de la couleur.
      *
-     * R, G et B sont des unsigned allant de 0 à 255 et
+     * R, G et B sont des octets allant de 0 à 255 et
      * représentant le taux de rouge, de vert et de bleu
-     * de la couleur.
+     * de la couleur, rangés sous la forme 0xRRGGBB.
      */
 
 public:
@@ -30,21 +33,41 @@ public:
 
     /*!
      * \brief Constructeur de \ref Color.
-     * \param code le code RGB de la couleur
+     * \param red le taux de rouge de la couleur
+     * \param green le taux de vert de la couleur
+     * \param blue le taux de bleu de la couleur
      */
-    explicit Color(std::vector<unsigned> &code);
+    Color(unsigned red, unsigned green, unsigned blue);
 
     /*!
-     * \brief Accesseur en lecture du code RGB de la \ref Color.
-     * \return le code RGB de la couleur
+     * \brief Accesseur en lecture du code RGB compacté de la \ref Color.
+     * \return le code RGB de la couleur sous la forme 0xRRGGBB
      */
-    std::vector<unsigned> getCode() const;
+    inline std::uint32_t getCode() const;
+
+    /*!
+     * \brief Accesseur en lecture du taux de rouge de la \ref Color.
+     * \return le taux de rouge, de 0 à 255
+     */
+    inline unsigned getRed() const;
+
+    /*!
+     * \brief Accesseur en lecture du taux de vert de la \ref Color.
+     * \return le taux de vert, de 0 à 255
+     */
+    inline unsigned getGreen() const;
+
+    /*!
+     * \brief Accesseur en lecture du taux de bleu de la \ref Color.
+     * \return le taux de bleu, de 0 à 255
+     */
+    inline unsigned getBlue() const;
 };
 
 //prototypes
 
 /*!
- * \brief Opérateur de test d'égalité de deux \ref Position.
+ * \brief Opérateur de test d'égalité de deux \ref Color.
  * \param lhs le membre de gauche
  * \param rhs le membre de droite
  * \return vrai si les deux membres de la comparaison sont égaux, faux sinon
@@ -57,6 +80,23 @@ bool operator==(const Color & lhs, const Color & rhs){
     return lhs.getCode() == rhs.getCode();
 }
 
+//méthodes inline
+std::uint32_t Color::getCode() const{
+    return code_;
+}
+
+unsigned Color::getRed() const{
+    return (code_ >> 16) & 0xFF;
+}
+
+unsigned Color::getGreen() const{
+    return (code_ >> 8) & 0xFF;
+}
+
+unsigned Color::getBlue() const{
+    return code_ & 0xFF;
+}
+
 } // namespace GJ_GW
 
 #endif // COLOR_H
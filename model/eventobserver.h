@@ -0,0 +1,35 @@
+#ifndef EVENTOBSERVER_H
+#define EVENTOBSERVER_H
+
+#include "gameevent.h"
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe abstraite représentant un observateur des \ref GameEvent d'une \ref Simulation.
+ *
+ * Contrairement à \ref Observer, il reçoit ce qui a changé plutôt que de
+ * relire tout l'état de la partie, et seulement pour les sortes d'événements
+ * auxquelles il s'est abonné par \ref Simulation::addEventObserver.
+ */
+class EventObserver{
+public:
+    /*!
+     * \brief Méthode virtuelle recevant un événement de la partie observée.
+     *
+     * Elle est appelée au moment de la modification, avant que la partie ne
+     * poursuive son pas : elle ne doit pas faire avancer la partie.
+     *
+     * \param event l'événement
+     */
+    virtual void onEvent(const GameEvent & event) = 0;
+
+    virtual ~EventObserver() = default;
+};
+
+} // namespace GJ_GW
+
+#endif // EVENTOBSERVER_H
@@ -0,0 +1,97 @@
+#include "eventqueue.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using namespace GJ_GW;
+
+EventQueue::EventQueue(std::size_t capacity): slots_(capacity), mask_{capacity - 1},
+    tail_{0}, headCache_{0}, dropped_{0}, head_{0}, tailCache_{0}{
+    if(capacity == 0 || (capacity & (capacity - 1)) != 0){
+        throw std::invalid_argument("la capacité de la file d'événements doit être une puissance de 2 : "
+                                    + std::to_string(capacity));
+    }
+    resetLatency();
+}
+
+void EventQueue::onEvent(const GameEvent & event){
+    push(event);
+}
+
+bool EventQueue::push(const GameEvent & event){
+    const std::size_t tail {tail_.load(std::memory_order_relaxed)};
+    if(tail - headCache_ == slots_.size()){
+        headCache_ = head_.load(std::memory_order_acquire);
+        if(tail - headCache_ == slots_.size()){
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    Slot & slot {slots_[tail & mask_]};
+    slot.event = event;
+    slot.published = now();
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool EventQueue::pop(GameEvent & event){
+    const std::size_t head {head_.load(std::memory_order_relaxed)};
+    if(head == tailCache_){
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        if(head == tailCache_){
+            return false;
+        }
+    }
+    const Slot & slot {slots_[head & mask_]};
+    event = slot.event;
+    const std::uint64_t latency {static_cast<std::uint64_t>(std::max<std::int64_t>(now() - slot.published, 0))};
+    head_.store(head + 1, std::memory_order_release);
+
+    unsigned bucket {latency < 2 ? 0u : 63u - __builtin_clzll(latency)};
+    ++histogram_[std::min(bucket, LATENCY_BUCKETS - 1)];
+    totalLatency_ += latency;
+    maxLatency_ = std::max(maxLatency_, latency);
+    return true;
+}
+
+EventLatency EventQueue::getLatency() const{
+    EventLatency latency {};
+    for(std::uint64_t count : histogram_){
+        latency.count += count;
+    }
+    if(latency.count == 0){
+        return latency;
+    }
+    latency.mean = totalLatency_ / latency.count;
+    latency.max = maxLatency_;
+    const std::uint64_t median {(latency.count + 1) / 2};
+    const std::uint64_t p99 {latency.count - latency.count / 100};
+    std::uint64_t seen {0};
+    for(unsigned b {0}; b < LATENCY_BUCKETS; ++b){
+        seen += histogram_[b];
+        if(latency.median == 0 && seen >= median){
+            latency.median = std::min(bound(b), maxLatency_);
+        }
+        if(seen >= p99){
+            latency.p99 = std::min(bound(b), maxLatency_);
+            break;
+        }
+    }
+    return latency;
+}
+
+void EventQueue::resetLatency(){
+    histogram_.fill(0);
+    totalLatency_ = 0;
+    maxLatency_ = 0;
+}
+
+std::int64_t EventQueue::now(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::uint64_t EventQueue::bound(unsigned bucket){
+    return (std::uint64_t(1) << (bucket + 1)) - 1;
+}
@@ -0,0 +1,236 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include "eventobserver.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure résumant le délai entre la publication et la lecture des événements
+ * d'une \ref EventQueue.
+ *
+ * Les durées sont en nanosecondes ; les centiles sont arrondis à la
+ * puissance de 2 supérieure.
+ */
+struct EventLatency{
+    std::uint64_t count;
+    /*!< Le nombre d'événements lus. */
+
+    std::uint64_t mean;
+    /*!< Le délai moyen. */
+
+    std::uint64_t median;
+    /*!< Le délai médian. */
+
+    std::uint64_t p99;
+    /*!< Le 99e centile du délai. */
+
+    std::uint64_t max;
+    /*!< Le plus long délai. */
+};
+
+/*!
+ * \brief Classe représentant une file bornée d'événements, sans verrou, entre
+ * un seul thread producteur et un seul thread consommateur.
+ *
+ * Abonnée à une \ref Simulation, elle reçoit ses \ref GameEvent dans le
+ * thread du jeu, qui ne fait que les copier dans un tableau circulaire alloué
+ * une fois pour toutes. Le rendu ou l'envoi sur le réseau les lisent ensuite
+ * à leur rythme, dans un autre thread ou à l'image suivante : un consommateur
+ * lent ne ralentit jamais leur publication.
+ *
+ * Le producteur n'attend jamais : si la file est pleine, l'événement est
+ * perdu et compté par \ref getDropped. Le consommateur qui en constate doit
+ * alors relire l'état complet de la partie.
+ *
+ * Chaque événement est daté à sa publication ; sa lecture alimente un
+ * histogramme des délais, consulté par \ref getLatency.
+ */
+class EventQueue : public EventObserver{
+public:
+    constexpr static std::size_t DEFAULT_CAPACITY {1024};
+    /*!< La capacité par défaut, en événements. */
+
+    constexpr static unsigned LATENCY_BUCKETS {40};
+    /*!< Le nombre de classes de l'histogramme des délais, la classe n°b
+     * comptant les délais de moins de 2^(b+1) nanosecondes. */
+
+private:
+    /*!
+     * \brief Structure représentant une case du tableau circulaire.
+     */
+    struct Slot{
+        GameEvent event;
+        /*!< L'événement. */
+
+        std::int64_t published;
+        /*!< L'instant de la publication, en nanosecondes. */
+    };
+
+    constexpr static std::size_t CACHE_LINE {64};
+    /*!< La taille d'une ligne de cache, qui sépare les données du producteur
+     * de celles du consommateur. */
+
+    std::vector<Slot> slots_;
+    /*!< Le tableau circulaire, dont la taille est une puissance de 2. */
+
+    std::size_t mask_;
+    /*!< La taille du tableau moins 1. */
+
+    char producerPadding_[CACHE_LINE];
+    /*!< Inutilisé : sépare les champs du producteur des précédents. */
+
+    std::atomic<std::size_t> tail_;
+    /*!< Le nombre d'événements écrits, modifié par le producteur seul. */
+
+    std::size_t headCache_;
+    /*!< La dernière valeur de \ref head_ lue par le producteur. */
+
+    std::atomic<std::uint64_t> dropped_;
+    /*!< Le nombre d'événements perdus faute de place. */
+
+    char consumerPadding_[CACHE_LINE];
+    /*!< Inutilisé : sépare les champs du consommateur de ceux du producteur. */
+
+    std::atomic<std::size_t> head_;
+    /*!< Le nombre d'événements lus, modifié par le consommateur seul. */
+
+    std::size_t tailCache_;
+    /*!< La dernière valeur de \ref tail_ lue par le consommateur. */
+
+    std::array<std::uint64_t, LATENCY_BUCKETS> histogram_;
+    /*!< L'histogramme des délais, tenu par le consommateur. */
+
+    std::uint64_t totalLatency_;
+    /*!< La somme des délais, en nanosecondes. */
+
+    std::uint64_t maxLatency_;
+    /*!< Le plus long délai, en nanosecondes. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref EventQueue.
+     *
+     * \param capacity le nombre d'événements que la file peut contenir, une puissance de 2
+     * \throw std::invalid_argument si la capacité n'est pas une puissance de 2
+     */
+    explicit EventQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+    EventQueue(const EventQueue &) = delete;
+    EventQueue & operator=(const EventQueue &) = delete;
+
+    /*!
+     * \brief Méthode recevant un événement de la partie, appelée dans le thread du jeu.
+     * \param event l'événement
+     */
+    void onEvent(const GameEvent & event) override;
+
+    /*!
+     * \brief Méthode ajoutant un événement à la file, sans attendre ni allouer.
+     *
+     * Elle ne doit être appelée que par le thread producteur.
+     *
+     * \param event l'événement
+     * \return true si l'événement a été ajouté, false s'il a été perdu faute de place
+     */
+    bool push(const GameEvent & event);
+
+    /*!
+     * \brief Méthode retirant le plus ancien événement de la file.
+     *
+     * Elle ne doit être appelée que par le thread consommateur.
+     *
+     * \param event reçoit l'événement retiré
+     * \return true si un événement a été retiré, false si la file était vide
+     */
+    bool pop(GameEvent & event);
+
+    /*!
+     * \brief Méthode retirant tous les événements présents et les passant à un traitement.
+     *
+     * Elle ne doit être appelée que par le thread consommateur.
+     *
+     * \param handle le traitement, appelé avec chaque événement dans l'ordre de publication
+     * \return le nombre d'événements traités
+     */
+    template<typename Handler>
+    std::size_t drain(Handler handle);
+
+    /*!
+     * \brief Accesseur en lecture de la capacité de la file.
+     * \return le nombre d'événements que la file peut contenir
+     */
+    inline std::size_t getCapacity() const;
+
+    /*!
+     * \brief Accesseur en lecture du nombre d'événements perdus faute de place.
+     *
+     * Il peut être lu depuis n'importe quel thread.
+     *
+     * \return le nombre d'événements perdus
+     */
+    inline std::uint64_t getDropped() const;
+
+    /*!
+     * \brief Méthode résumant les délais des événements lus depuis le dernier
+     * appel à \ref resetLatency.
+     *
+     * Elle ne doit être appelée que par le thread consommateur.
+     *
+     * \return le résumé des délais, nul si aucun événement n'a été lu
+     */
+    EventLatency getLatency() const;
+
+    /*!
+     * \brief Méthode oubliant les délais déjà mesurés.
+     *
+     * Elle ne doit être appelée que par le thread consommateur.
+     */
+    void resetLatency();
+
+private:
+    /*!
+     * \brief Méthode donnant l'instant présent sur une horloge monotone.
+     * \return l'instant, en nanosecondes
+     */
+    static std::int64_t now();
+
+    /*!
+     * \brief Méthode donnant la borne supérieure des délais d'une classe de l'histogramme.
+     * \param bucket la classe
+     * \return la borne, en nanosecondes
+     */
+    static std::uint64_t bound(unsigned bucket);
+};
+
+//méthodes inline
+template<typename Handler>
+std::size_t EventQueue::drain(Handler handle){
+    std::size_t count {0};
+    GameEvent event;
+    while(pop(event)){
+        handle(event);
+        ++count;
+    }
+    return count;
+}
+
+std::size_t EventQueue::getCapacity() const{
+    return slots_.size();
+}
+
+std::uint64_t EventQueue::getDropped() const{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+} // namespace GJ_GW
+
+#endif // EVENTQUEUE_H
@@ -0,0 +1,96 @@
+#ifndef GAMEEVENT_H
+#define GAMEEVENT_H
+
+#include "gamestate.h"
+#include "placement.h"
+#include "row.h"
+#include <type_traits>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Énumération fortement typée des sortes d'événements publiés par une \ref Simulation.
+ */
+enum class GameEventKind{
+    /*! Une nouvelle \ref Bric courante a été mise en jeu. */
+    PIECE_SPAWNED,
+    /*! La \ref Bric courante a été déplacée ou tournée. */
+    PIECE_MOVED,
+    /*! La \ref Bric courante a été fixée dans la grille, faute de pouvoir descendre. */
+    PIECE_LOCKED,
+    /*! Des lignes pleines ont été vidées. */
+    LINES_CLEARED,
+    /*! Des lignes grises ont été ajoutées au bas de la grille. */
+    GARBAGE_RECEIVED,
+    /*! Le score ou le nombre de lignes du \ref Player a changé. */
+    SCORE_CHANGED,
+    /*! Le \ref GameState a changé. */
+    STATE_CHANGED
+};
+
+/*!
+ * \brief Structure représentant un événement d'une partie et sa charge utile.
+ *
+ * Seuls les champs utiles à la sorte d'événement sont remplis :
+ * - \ref GameEventKind::PIECE_SPAWNED et \ref GameEventKind::PIECE_LOCKED :
+ *   \ref bric et \ref to ;
+ * - \ref GameEventKind::PIECE_MOVED : \ref bric, \ref from et \ref to ;
+ * - \ref GameEventKind::LINES_CLEARED : \ref rows ;
+ * - \ref GameEventKind::GARBAGE_RECEIVED : \ref count ;
+ * - \ref GameEventKind::SCORE_CHANGED : \ref score et \ref lines ;
+ * - \ref GameEventKind::STATE_CHANGED : \ref state.
+ *
+ * Elle ne contient que des entiers : elle se copie d'un bloc.
+ */
+struct GameEvent{
+    constexpr static unsigned ALL {(1u << (static_cast<unsigned>(GameEventKind::STATE_CHANGED) + 1)) - 1};
+    /*!< Le masque de toutes les sortes d'événements. */
+
+    GameEventKind kind;
+    /*!< La sorte d'événement. */
+
+    unsigned bric;
+    /*!< L'indice de la \ref Bric dans le sac. */
+
+    Placement from;
+    /*!< L'orientation et la position de la brique avant son déplacement. */
+
+    Placement to;
+    /*!< L'orientation et la position de la brique après son déplacement, à sa mise en jeu ou à sa fixation. */
+
+    Column rows;
+    /*!< Les lignes vidées, le bit n°y représentant la ligne y. */
+
+    unsigned count;
+    /*!< Le nombre de lignes grises ajoutées. */
+
+    unsigned score;
+    /*!< Le nouveau score du joueur. */
+
+    unsigned lines;
+    /*!< Le nouveau nombre de lignes remplies par le joueur. */
+
+    GameState state;
+    /*!< Le nouvel état de la partie. */
+
+    /*!
+     * \brief Méthode donnant le masque d'une sorte d'événement, pour s'y abonner.
+     *
+     * Les masques se combinent par un ou binaire.
+     *
+     * \param kind la sorte d'événement
+     * \return le masque
+     */
+    constexpr static unsigned mask(GameEventKind kind){
+        return 1u << static_cast<unsigned>(kind);
+    }
+};
+
+static_assert(std::is_trivially_copyable<GameEvent>::value, "un événement doit se copier d'un bloc");
+
+} // namespace GJ_GW
+
+#endif // GAMEEVENT_H
@@ -0,0 +1,113 @@
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include "boardkernel.h"
+#include "bricsBag.h"
+#include "gamestate.h"
+#include "palette.h"
+#include "row.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure représentant l'état complet d'une partie à un instant donné.
+ *
+ * Elle est obtenue par \ref Simulation::capture et ré-appliquée par
+ * \ref Simulation::restore. Elle ne contient que des tableaux de taille fixe
+ * et des entiers : elle se copie d'un bloc, sans allocation, ce qui permet
+ * de l'utiliser pour chercher un coup, annuler une action ou revenir en
+ * arrière lors d'une partie en réseau.
+ *
+ * Elle ne décrit que l'état du jeu, pas sa configuration : elle ne peut être
+ * restaurée que dans une partie de même grille et de même sac, comme celle
+ * où elle a été prise ou la même partie rejouée par un \ref Replay.
+ */
+struct GameSnapshot{
+    unsigned width;
+    /*!< La largeur de la grille. */
+
+    unsigned height;
+    /*!< La hauteur de la grille. */
+
+    unsigned colors;
+    /*!< Le nombre de couleurs de la palette de la grille. */
+
+    std::array<std::uint32_t, Palette::MAXIMUM_COLORS> palette;
+    /*!< Les codes des couleurs de la palette, rangées par indice. */
+
+    std::array<Row, BoardKernel::MAXIMUM_HEIGHT> rows;
+    /*!< L'occupation des lignes de la grille. */
+
+    std::array<Column, BoardKernel::MAXIMUM_WIDTH> columns;
+    /*!< L'occupation des colonnes de la grille. */
+
+    std::array<std::uint8_t, BoardKernel::MAXIMUM_WIDTH * BoardKernel::MAXIMUM_HEIGHT> cells;
+    /*!< Les indices de couleur des cases de la grille, rangées ligne par ligne. */
+
+    std::uint64_t hash;
+    /*!< La clé de \ref Zobrist de la grille. */
+
+    unsigned brics;
+    /*!< Le nombre de briques du sac. */
+
+    std::array<std::uint32_t, 4> random;
+    /*!< L'état du générateur du sac. */
+
+    std::array<unsigned, BricsBag::MAXIMUM_PREVIEW + 1> queue;
+    /*!< Les indices des briques tirées, la brique courante en premier. */
+
+    unsigned count;
+    /*!< Le nombre d'indices valides dans \ref queue. */
+
+    std::array<unsigned, BricsBag::HISTORY_SIZE> history;
+    /*!< Les indices des dernières briques tirées, de la plus récente à la plus ancienne. */
+
+    unsigned historySize;
+    /*!< Le nombre d'indices valides dans \ref history. */
+
+    std::array<std::uint8_t, BricsBag::MAXIMUM_BRICS> remaining;
+    /*!< Les indices des briques restant à distribuer par \ref BagPolicy::SEVEN_BAG. */
+
+    unsigned remainingSize;
+    /*!< Le nombre d'indices valides dans \ref remaining. */
+
+    unsigned rotation;
+    /*!< L'orientation de la brique courante. */
+
+    unsigned x;
+    /*!< L'abscisse du milieu de la brique courante. */
+
+    unsigned y;
+    /*!< L'ordonnée du milieu de la brique courante. */
+
+    unsigned score;
+    /*!< Le score du joueur. */
+
+    unsigned lines;
+    /*!< Le nombre de lignes remplies par le joueur. */
+
+    unsigned level;
+    /*!< Le niveau de difficulté au démarrage de la partie. */
+
+    GameState gameState;
+    /*!< L'état de la partie. */
+
+    Column clearedRows;
+    /*!< Les lignes vidées lors de la dernière pose de brique. */
+
+    unsigned elapsed;
+    /*!< Le temps de jeu écoulé en milliseconde, 0 pour une partie sans horloge. */
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value && std::is_standard_layout<GameSnapshot>::value,
+              "un instantané doit pouvoir être copié d'un bloc");
+
+} // namespace GJ_GW
+
+#endif // GAMESNAPSHOT_H
@@ -0,0 +1,30 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Énumération fortement typée pour représenter l'action appliquée lors d'un pas
+ * de la \ref Simulation.
+ */
+enum class Input{
+    /*! Aucune action du joueur : la brique courante descend d'une case. */
+    NONE,
+    /*! Représente un déplacement vers la gauche. */
+    LEFT,
+    /*! Représente un déplacement vers la droite. */
+    RIGHT,
+    /*! Représente un déplacement vers le bas. */
+    DOWN,
+    /*! Représente une rotation de 90°. */
+    ROTATE,
+    /*! Représente une chute jusqu'au bas de la grille. */
+    DROP
+};
+
+} // namespace GJ_GW
+
+#endif // INPUT_H
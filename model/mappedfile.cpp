@@ -0,0 +1,73 @@
+#include "mappedfile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace GJ_GW;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string & path): data_{nullptr}, size_{0}{
+    HANDLE file {CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr)};
+    if(file == INVALID_HANDLE_VALUE){
+        throw std::invalid_argument("impossible d'ouvrir " + path);
+    }
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0){
+        CloseHandle(file);
+        throw std::invalid_argument("fichier vide ou illisible : " + path);
+    }
+    HANDLE mapping {CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+    // la vue garde la projection ouverte : les deux poignées peuvent être fermées
+    CloseHandle(file);
+    if(!mapping){
+        throw std::invalid_argument("impossible de projeter " + path);
+    }
+    void * data {MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+    CloseHandle(mapping);
+    if(!data){
+        throw std::invalid_argument("impossible de projeter " + path);
+    }
+    data_ = static_cast<const std::uint8_t *>(data);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile(){
+    UnmapViewOfFile(data_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string & path): data_{nullptr}, size_{0}{
+    int file {open(path.c_str(), O_RDONLY)};
+    if(file < 0){
+        throw std::invalid_argument("impossible d'ouvrir " + path);
+    }
+    struct stat status;
+    if(fstat(file, &status) != 0 || status.st_size == 0){
+        close(file);
+        throw std::invalid_argument("fichier vide ou illisible : " + path);
+    }
+    void * data {mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0)};
+    // la projection reste valide après la fermeture du descripteur
+    close(file);
+    if(data == MAP_FAILED){
+        throw std::invalid_argument("impossible de projeter " + path);
+    }
+    data_ = static_cast<const std::uint8_t *>(data);
+    size_ = static_cast<std::size_t>(status.st_size);
+}
+
+MappedFile::~MappedFile(){
+    munmap(const_cast<std::uint8_t *>(data_), size_);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe projetant un fichier en mémoire, en lecture seule.
+ *
+ * Le contenu du fichier est lu par le système à la demande, page par page :
+ * seules les parties effectivement consultées sont chargées, et plusieurs
+ * processus lisant le même fichier partagent les mêmes pages.
+ */
+class MappedFile{
+    const std::uint8_t * data_;
+    /*!< Le début du fichier projeté. */
+
+    std::size_t size_;
+    /*!< La taille du fichier en octets. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref MappedFile.
+     *
+     * \param path le chemin du fichier
+     * \throw std::invalid_argument si le fichier ne peut être ouvert, est vide
+     * ou ne peut être projeté
+     */
+    explicit MappedFile(const std::string & path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    /*!
+     * \brief Destructeur de \ref MappedFile.
+     *
+     * Les pointeurs vers le contenu du fichier deviennent invalides.
+     */
+    ~MappedFile();
+
+    /*!
+     * \brief Accesseur en lecture du contenu du fichier.
+     * \return le début du fichier
+     */
+    inline const std::uint8_t * getData() const;
+
+    /*!
+     * \brief Accesseur en lecture de la taille du fichier.
+     * \return la taille en octets
+     */
+    inline std::size_t getSize() const;
+};
+
+//méthodes inline
+const std::uint8_t * MappedFile::getData() const{
+    return data_;
+}
+
+std::size_t MappedFile::getSize() const{
+    return size_;
+}
+
+} // namespace GJ_GW
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,221 @@
+#include "movegenerator.h"
+#include "direction.h"
+#include <algorithm>
+
+using namespace GJ_GW;
+
+std::size_t MoveGenerator::generate(const Board & board, const Bric & bric, bool placed,
+                                    std::vector<Placement> & placements){
+    placements.clear();
+    const unsigned width {board.getWidth()};
+    const unsigned height {board.getHeight()};
+    std::array<Row, Board::MAXIMUM_HEIGHT> rows;
+    for(unsigned y {0}; y < height; ++y){
+        rows[y] = placed? board.getRow(y) & ~bric.getRowMask(y) : board.getRow(y);
+    }
+
+    States fit;
+    std::array<unsigned, ORIENTATIONS> tops;
+    computeFit(rows.data(), width, height, bric, fit, tops);
+
+    const Bric::Orientation & start {bric.orientations_[bric.rotation_]};
+    int left {static_cast<int>(bric.middle_.getX()) + start.left};
+    int top {static_cast<int>(bric.middle_.getY()) + start.top};
+    if(left < 0 || top < 0 || static_cast<unsigned>(top) >= tops[bric.rotation_]
+            || !(fit[bric.rotation_][top] >> left & 1)){
+        return 0;
+    }
+    States reach {};
+    reach[bric.rotation_][top] = static_cast<Row>(1u << left);
+    propagate(bric, fit, tops, reach);
+
+    // une orientation identique à une précédente couvre les mêmes cases pour un même cadre
+    std::array<unsigned, ORIENTATIONS> canonical;
+    for(unsigned r {0}; r < ORIENTATIONS; ++r){
+        const Bric::Orientation & o {bric.orientations_[r]};
+        canonical[r] = r;
+        for(unsigned s {0}; s < r && canonical[r] == r; ++s){
+            const Bric::Orientation & p {bric.orientations_[s]};
+            if(o.rows == p.rows && o.width == p.width && o.height == p.height){
+                canonical[r] = s;
+            }
+        }
+    }
+
+    States seen {};
+    for(unsigned r {0}; r < ORIENTATIONS; ++r){
+        const Bric::Orientation & o {bric.orientations_[r]};
+        for(unsigned t {0}; t < tops[r]; ++t){
+            Row below {(t + 1 < tops[r])? fit[r][t + 1] : Row(0)};
+            Row locked {static_cast<Row>(reach[r][t] & ~below & ~seen[canonical[r]][t])};
+            seen[canonical[r]][t] |= locked;
+            for(; locked != 0; locked &= locked - 1){
+                int l {__builtin_ctz(locked)};
+                placements.push_back(Placement{r, l - o.left, static_cast<int>(t) - o.top});
+            }
+        }
+    }
+    return placements.size();
+}
+
+bool MoveGenerator::path(const Board & board, const Bric & bric, bool placed, const Placement & target,
+                         std::vector<Input> & inputs){
+    inputs.clear();
+    const unsigned height {board.getHeight()};
+    std::array<Row, Board::MAXIMUM_HEIGHT> rows;
+    for(unsigned y {0}; y < height; ++y){
+        rows[y] = placed? board.getRow(y) & ~bric.getRowMask(y) : board.getRow(y);
+    }
+    States fit;
+    std::array<unsigned, ORIENTATIONS> tops;
+    computeFit(rows.data(), board.getWidth(), height, bric, fit, tops);
+
+    // un état (orientation, ligne, abscisse) du cadre est numéroté ((r * hauteur) + t) * largeur + l
+    constexpr unsigned W {Board::MAXIMUM_WIDTH};
+    constexpr unsigned STATES {ORIENTATIONS * Board::MAXIMUM_HEIGHT * W};
+    auto valid = [&fit, &tops](unsigned r, int t, int l){
+        return t >= 0 && l >= 0 && static_cast<unsigned>(t) < tops[r] && l < static_cast<int>(W)
+                && (fit[r][t] >> l & 1);
+    };
+    const Bric::Orientation & from {bric.orientations_[bric.rotation_]};
+    int left {static_cast<int>(bric.middle_.getX()) + from.left};
+    int top {static_cast<int>(bric.middle_.getY()) + from.top};
+    if(target.rotation >= ORIENTATIONS || !valid(bric.rotation_, top, left)){
+        return false;
+    }
+    const Bric::Orientation & to {bric.orientations_[target.rotation]};
+    const unsigned goal {(target.rotation * Board::MAXIMUM_HEIGHT + (target.y + to.top)) * W
+                + (target.x + to.left)};
+    if(!valid(target.rotation, target.y + to.top, target.x + to.left)){
+        return false;
+    }
+
+    std::array<std::uint16_t, STATES> parent;
+    std::array<Input, STATES> via;
+    std::array<std::uint16_t, STATES> queue;
+    parent.fill(STATES);
+    unsigned head {0};
+    unsigned tail {0};
+    const unsigned start {(bric.rotation_ * Board::MAXIMUM_HEIGHT + top) * W + left};
+    parent[start] = start;
+    queue[tail++] = start;
+    while(head < tail && parent[goal] == STATES){
+        const unsigned state {queue[head++]};
+        const unsigned r {state / (Board::MAXIMUM_HEIGHT * W)};
+        const int t {static_cast<int>(state / W % Board::MAXIMUM_HEIGHT)};
+        const int l {static_cast<int>(state % W)};
+        const unsigned next {(r + 1) % ORIENTATIONS};
+        const int dx {bric.orientations_[next].left - bric.orientations_[r].left};
+        const int dy {bric.orientations_[next].top - bric.orientations_[r].top};
+        const struct{ unsigned r; int t; int l; Input input; } moves[] {
+            {r, t + 1, l, Input::DOWN}, {r, t, l - 1, Input::LEFT},
+            {r, t, l + 1, Input::RIGHT}, {next, t + dy, l + dx, Input::ROTATE}
+        };
+        for(const auto & move : moves){
+            if(valid(move.r, move.t, move.l)){
+                unsigned reached {(move.r * Board::MAXIMUM_HEIGHT + move.t) * W + move.l};
+                if(parent[reached] == STATES){
+                    parent[reached] = state;
+                    via[reached] = move.input;
+                    queue[tail++] = reached;
+                }
+            }
+        }
+    }
+    if(parent[goal] == STATES){
+        return false;
+    }
+    for(unsigned state {goal}; state != start; state = parent[state]){
+        inputs.push_back(via[state]);
+    }
+    std::reverse(inputs.begin(), inputs.end());
+    while(!inputs.empty() && inputs.back() == Input::DOWN){
+        inputs.pop_back();
+    }
+    inputs.push_back(Input::DROP);
+    return true;
+}
+
+Bric MoveGenerator::spawn(const Bric & bric, unsigned width){
+    Bric spawned {bric};
+    unsigned midBoard = width/2;
+    unsigned midBric = spawned.middle_.getX() + 1;
+    for(unsigned u {0}; u + midBric < midBoard; ++u){
+        spawned.move(Direction::RIGHT);
+    }
+    return spawned;
+}
+
+unsigned MoveGenerator::apply(Board & board, const Bric & bric, bool placed, const Placement & placement){
+    if(placed){
+        board.removeBric(bric);
+    }
+    Bric moved {bric};
+    moved.rotation_ = placement.rotation;
+    moved.middle_ = Position(placement.x, placement.y);
+    board.addBric(moved);
+    return __builtin_popcount(board.clearLines());
+}
+
+void MoveGenerator::computeFit(const Row * rows, unsigned width, unsigned height, const Bric & bric,
+                               States & fit, std::array<unsigned, ORIENTATIONS> & tops){
+    for(unsigned r {0}; r < ORIENTATIONS; ++r){
+        const Bric::Orientation & o {bric.orientations_[r]};
+        if(o.width > width || o.height > height){
+            tops[r] = 0;
+            continue;
+        }
+        tops[r] = height - o.height + 1;
+        const Row lefts {static_cast<Row>((1u << (width - o.width + 1)) - 1)};
+        for(unsigned t {0}; t < tops[r]; ++t){
+            // le cadre en x heurte la grille si une case b de la brique tombe sur une case x + b pleine
+            unsigned blocked {0};
+            for(unsigned v {0}; v < o.height; ++v){
+                for(Row cells {o.rows[v]}; cells != 0; cells &= cells - 1){
+                    blocked |= rows[t + v] >> __builtin_ctz(cells);
+                }
+            }
+            fit[r][t] = static_cast<Row>(lefts & ~blocked);
+        }
+    }
+}
+
+void MoveGenerator::propagate(const Bric & bric, const States & fit,
+                              const std::array<unsigned, ORIENTATIONS> & tops, States & reach){
+    bool grown {1};
+    while(grown){
+        grown = 0;
+        for(unsigned r {0}; r < ORIENTATIONS; ++r){
+            const Bric::Orientation & o {bric.orientations_[r]};
+            const unsigned next {(r + 1) % ORIENTATIONS};
+            const Bric::Orientation & n {bric.orientations_[next]};
+            const int dx {n.left - o.left};
+            const int dy {n.top - o.top};
+            for(unsigned t {0}; t < tops[r]; ++t){
+                unsigned states {reach[r][t]};
+                if(states == 0){
+                    continue;
+                }
+                unsigned spread;
+                do{
+                    spread = states;
+                    states |= ((states << 1) | (states >> 1)) & fit[r][t];
+                } while(states != spread);
+                reach[r][t] = static_cast<Row>(states);
+
+                if(t + 1 < tops[r]){
+                    reach[r][t + 1] |= states & fit[r][t + 1];
+                }
+
+                int u {static_cast<int>(t) + dy};
+                if(u >= 0 && static_cast<unsigned>(u) < tops[next]){
+                    unsigned shifted {(dx >= 0)? states << dx : states >> -dx};
+                    Row rotated {static_cast<Row>(shifted & fit[next][u])};
+                    // seule l'orientation n°0, déjà parcourue, demande un nouveau passage
+                    grown |= next < r && (rotated & ~reach[next][u]) != 0;
+                    reach[next][u] |= rotated;
+                }
+            }
+        }
+    }
+}
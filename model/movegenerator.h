@@ -0,0 +1,131 @@
+#ifndef MOVEGENERATOR_H
+#define MOVEGENERATOR_H
+
+#include "board.h"
+#include "bric.h"
+#include "placement.h"
+#include "input.h"
+#include <array>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe énumérant les positions finales qu'une \ref Bric peut atteindre.
+ *
+ * Depuis sa position actuelle, la brique peut se déplacer à gauche, à droite,
+ * vers le bas et tourner, comme le ferait le joueur entre deux descentes :
+ * les glissements sous un surplomb et les rotations en fin de chute sont donc
+ * trouvés. Une position finale est une position atteignable d'où la brique
+ * ne peut plus descendre.
+ *
+ * La recherche ne copie ni la grille ni la brique : pour chaque orientation et
+ * chaque ligne, les abscisses où la brique tient sont calculées en un masque
+ * (\ref Row) à partir des masques de lignes de la brique, puis les états
+ * (orientation, ligne, abscisse) atteints sont marqués dans des masques de même
+ * forme et propagés par décalages binaires jusqu'à stabilité.
+ */
+class MoveGenerator{
+    constexpr static unsigned ORIENTATIONS {4};
+    /*!< Le nombre d'orientations d'une \ref Bric. */
+
+    static_assert(ORIENTATIONS == Bric::ORIENTATIONS, "le générateur doit parcourir toutes les orientations");
+
+    /*!
+     * \brief Type des masques d'états : pour chaque orientation et chaque ligne
+     * du haut du cadre de la brique, le bit n°x représente l'abscisse x du cadre.
+     */
+    using States = std::array<std::array<Row, Board::MAXIMUM_HEIGHT>, ORIENTATIONS>;
+
+public:
+    constexpr static unsigned MAXIMUM_PLACEMENTS {ORIENTATIONS * Board::MAXIMUM_WIDTH * Board::MAXIMUM_HEIGHT};
+    /*!< Le nombre maximal de positions finales renvoyées par \ref generate. */
+
+    /*!
+     * \brief Méthode cherchant les positions finales distinctes d'une \ref Bric.
+     *
+     * Deux positions couvrant les mêmes cases, par exemple deux orientations
+     * symétriques, ne sont renvoyées qu'une fois.
+     *
+     * \param board la grille de jeu
+     * \param bric la brique, dans sa position de départ
+     * \param placed vrai si la brique est déjà dans la grille, ses cases sont alors
+     * considérées comme vides
+     * \param placements reçoit les positions finales, il est vidé au préalable afin
+     * de réutiliser sa capacité d'un appel à l'autre
+     * \return le nombre de positions finales, 0 si la brique ne tient pas à son départ
+     */
+    static std::size_t generate(const Board & board, const Bric & bric, bool placed,
+                                std::vector<Placement> & placements);
+
+    /*!
+     * \brief Méthode cherchant la plus courte suite d'actions menant une \ref Bric
+     * à une position finale.
+     *
+     * La suite se termine par \ref Input::DROP, qui remplace les descentes finales.
+     *
+     * \param board la grille de jeu
+     * \param bric la brique, dans sa position actuelle
+     * \param placed vrai si la brique est déjà dans la grille
+     * \param target la position finale, telle que renvoyée par \ref generate
+     * \param inputs reçoit les actions, il est vidé au préalable
+     * \return true si la position est atteignable, false sinon
+     */
+    static bool path(const Board & board, const Bric & bric, bool placed, const Placement & target,
+                     std::vector<Input> & inputs);
+
+    /*!
+     * \brief Méthode plaçant une \ref Bric dans sa position de départ.
+     *
+     * Comme lors de la mise en jeu, la brique est centrée en haut de la grille.
+     *
+     * \param bric la brique, dans sa position d'origine
+     * \param width la largeur de la grille
+     * \return la brique dans sa position de départ
+     */
+    static Bric spawn(const Bric & bric, unsigned width);
+
+    /*!
+     * \brief Méthode posant une \ref Bric à une position finale puis vidant les lignes pleines.
+     *
+     * \param board la grille de jeu
+     * \param bric la brique
+     * \param placed vrai si la brique est déjà dans la grille, elle en est alors retirée
+     * \param placement la position finale, où la brique doit tenir
+     * \return le nombre de lignes vidées
+     */
+    static unsigned apply(Board & board, const Bric & bric, bool placed, const Placement & placement);
+
+private:
+    /*!
+     * \brief Méthode calculant les positions où la \ref Bric tient dans la grille.
+     *
+     * \param rows les lignes de la grille, sans la brique
+     * \param width la largeur de la grille
+     * \param height la hauteur de la grille
+     * \param bric la brique
+     * \param fit reçoit, pour chaque orientation et chaque ligne, les abscisses
+     * du cadre où la brique tient
+     * \param tops reçoit, pour chaque orientation, le nombre de lignes où le cadre peut se trouver
+     */
+    static void computeFit(const Row * rows, unsigned width, unsigned height, const Bric & bric,
+                           States & fit, std::array<unsigned, ORIENTATIONS> & tops);
+
+    /*!
+     * \brief Méthode marquant tous les états atteignables depuis ceux déjà marqués.
+     *
+     * \param bric la brique
+     * \param fit les positions où la brique tient
+     * \param tops le nombre de lignes où le cadre peut se trouver, par orientation
+     * \param reach les états atteints, complétés jusqu'à stabilité
+     */
+    static void propagate(const Bric & bric, const States & fit,
+                          const std::array<unsigned, ORIENTATIONS> & tops, States & reach);
+};
+
+} // namespace GJ_GW
+
+#endif // MOVEGENERATOR_H
@@ -0,0 +1,26 @@
+#include "palette.h"
+#include <stdexcept>
+#include <string>
+
+using namespace GJ_GW;
+
+Palette::Palette(): size_{1}{
+    colors_.fill(Color());
+}
+
+std::uint8_t Palette::intern(Color color){
+    for(unsigned u {0}; u < size_; ++u){
+        if(colors_[u] == color){
+            return u;
+        }
+    }
+    if(size_ == MAXIMUM_COLORS){
+        throw std::length_error("la palette ne peut contenir plus de "+ std::to_string(MAXIMUM_COLORS) +" couleurs");
+    }
+    colors_[size_] = color;
+    return size_++;
+}
+
+unsigned Palette::getSize() const{
+    return size_;
+}
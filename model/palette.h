@@ -0,0 +1,72 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include "color.h"
+#include <array>
+#include <cstdint>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe représentant la table des couleurs utilisées au cours d'une partie.
+ *
+ * Chaque \ref Color n'y est stockée qu'une seule fois et est désignée par
+ * son indice, ce qui permet de ne stocker qu'un octet par case de la grille.
+ * L'indice 0 est réservé à la couleur blanche, celle des cases vides.
+ */
+class Palette{
+public:
+    constexpr static unsigned MAXIMUM_COLORS {66};
+    /*!< Le nombre maximum de couleurs différentes d'une partie : une par brique
+     * du plus grand sac, le blanc des cases vides et le gris des lignes ajoutées. */
+
+private:
+    std::array<Color, MAXIMUM_COLORS> colors_;
+    /*!< Les couleurs de la palette, rangées par indice. */
+
+    unsigned size_;
+    /*!< Le nombre de couleurs de la palette. */
+
+public:
+    /*!
+     * \brief Constructeur sans argument de \ref Palette.
+     *
+     * Il initialise la palette avec la seule couleur blanche.
+     */
+    Palette();
+
+    /*!
+     * \brief Méthode renvoyant l'indice d'une \ref Color, en l'ajoutant
+     * à la palette si elle n'y est pas encore.
+     *
+     * \param color la couleur à rechercher
+     * \return l'indice de la couleur
+     * \throw std::length_error si la palette est pleine
+     */
+    std::uint8_t intern(Color color);
+
+    /*!
+     * \brief Accesseur en lecture d'une \ref Color de la palette.
+     * \param index l'indice de la couleur
+     * \return la couleur
+     */
+    inline Color getColor(std::uint8_t index) const;
+
+    /*!
+     * \brief Accesseur en lecture du nombre de couleurs de la palette.
+     * \return le nombre de couleurs
+     */
+    unsigned getSize() const;
+};
+
+//méthodes inline
+Color Palette::getColor(std::uint8_t index) const{
+    return colors_[index];
+}
+
+} // namespace GJ_GW
+
+#endif // PALETTE_H
@@ -0,0 +1,28 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure représentant une position finale d'une \ref Bric dans la grille.
+ *
+ * Elle est décrite comme la brique elle-même : par l'indice de son orientation
+ * et par la position de son milieu.
+ */
+struct Placement{
+    unsigned rotation;
+    /*!< L'indice de l'orientation, le nombre de rotations depuis la forme de départ. */
+
+    int x;
+    /*!< L'abscisse du milieu de la brique. */
+
+    int y;
+    /*!< L'ordonnée du milieu de la brique. */
+};
+
+} // namespace GJ_GW
+
+#endif // PLACEMENT_H
@@ -15,7 +15,7 @@ namespace GJ_GW{
  * qu'il a rempli au cours de la partie
  */
 class Player{
-    friend class Tetris;
+    friend class Simulation;
 
     std::string name_;
     /*!< Le nom du joueur. */
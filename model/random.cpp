@@ -0,0 +1,35 @@
+#include "random.h"
+
+using namespace GJ_GW;
+
+Random::Random(std::uint64_t seed){
+    this->seed(seed);
+}
+
+void Random::seed(std::uint64_t seed){
+    for(unsigned u {0}; u < state_.size(); u += 2){
+        seed += 0x9e3779b97f4a7c15ull;
+        std::uint64_t z {seed};
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        state_[u] = static_cast<std::uint32_t>(z);
+        state_[u + 1] = static_cast<std::uint32_t>(z >> 32);
+    }
+    if(state_[0] == 0 && state_[1] == 0 && state_[2] == 0 && state_[3] == 0){
+        state_[0] = 1;
+    }
+}
+
+std::uint32_t Random::below(std::uint32_t bound){
+    std::uint64_t product {static_cast<std::uint64_t>((*this)()) * bound};
+    std::uint32_t low {static_cast<std::uint32_t>(product)};
+    if(low < bound){
+        const std::uint32_t threshold {(0u - bound) % bound};
+        while(low < threshold){
+            product = static_cast<std::uint64_t>((*this)()) * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
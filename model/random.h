@@ -0,0 +1,115 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe représentant un générateur pseudo-aléatoire xoshiro128**.
+ *
+ * Contrairement aux moteurs et aux distributions de la bibliothèque standard,
+ * dont les résultats dépendent de l'implémentation, la suite produite ne dépend
+ * que de la graine : deux machines et deux compilateurs différents tirent
+ * les mêmes nombres. Son état tient dans 16 octets et un tirage ne coûte que
+ * quelques instructions.
+ *
+ * Elle satisfait UniformRandomBitGenerator et peut donc être passée aux
+ * algorithmes de la bibliothèque standard.
+ */
+class Random{
+    friend class Simulation;
+
+    std::array<std::uint32_t, 4> state_;
+    /*!< L'état du générateur, jamais entièrement nul. */
+
+public:
+    typedef std::uint32_t result_type;
+    /*!< Le type des nombres tirés. */
+
+    /*!
+     * \brief Constructeur de \ref Random.
+     *
+     * \param seed la graine du générateur
+     */
+    explicit Random(std::uint64_t seed = 0);
+
+    /*!
+     * \brief Méthode ré-initialisant le générateur.
+     *
+     * L'état est dérivé de la graine par splitmix64, de sorte que des graines
+     * proches donnent des suites indépendantes.
+     *
+     * \param seed la graine du générateur
+     */
+    void seed(std::uint64_t seed);
+
+    /*!
+     * \brief Méthode tirant un nombre uniformément réparti sur 32 bits.
+     * \return le nombre tiré
+     */
+    inline result_type operator()();
+
+    /*!
+     * \brief Méthode tirant un entier uniformément réparti dans [0, bound[.
+     *
+     * Le tirage n'est pas biaisé : la méthode multiplicative de Lemire
+     * rejette les rares valeurs qui le seraient.
+     *
+     * \param bound la borne exclue, non nulle
+     * \return l'entier tiré
+     */
+    std::uint32_t below(std::uint32_t bound);
+
+    /*!
+     * \brief Accesseur en lecture de la plus petite valeur tirée.
+     * \return 0
+     */
+    constexpr static result_type min(){
+        return 0;
+    }
+
+    /*!
+     * \brief Accesseur en lecture de la plus grande valeur tirée.
+     * \return \f$2^{32}-1\f$
+     */
+    constexpr static result_type max(){
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    /*!
+     * \brief Méthode effectuant une rotation à gauche.
+     *
+     * \param x le mot à tourner
+     * \param k le nombre de bits de la rotation, entre 1 et 31
+     * \return le mot tourné
+     */
+    inline static std::uint32_t rotate(std::uint32_t x, unsigned k);
+};
+
+//méthodes inline
+Random::result_type Random::operator()(){
+    const std::uint32_t result {rotate(state_[1] * 5, 7) * 9};
+    const std::uint32_t t {state_[1] << 9};
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotate(state_[3], 11);
+    return result;
+}
+
+std::uint32_t Random::rotate(std::uint32_t x, unsigned k){
+    return (x << k) | (x >> (32 - k));
+}
+
+} // namespace GJ_GW
+
+#endif // RANDOM_H
@@ -0,0 +1,412 @@
+#include "replay.h"
+#include "simulation.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Le code de la fin des actions, suivi du nombre de descentes restantes.
+ */
+constexpr unsigned END {0};
+
+/*!
+ * \brief Le code d'un point de contrôle, suivi de l'empreinte de l'état du jeu.
+ */
+constexpr unsigned CHECK {6};
+
+/*!
+ * \brief Le code d'un ajout de lignes par \ref Simulation::addLine.
+ */
+constexpr unsigned LINES {7};
+
+/*!
+ * \brief Le code de la fin du temps signalée par \ref Simulation::timeOut.
+ */
+constexpr unsigned TIME_OUT {8};
+
+/*!
+ * \brief Le nombre de bits du code d'une action.
+ */
+constexpr unsigned CODE_BITS {4};
+
+/*!
+ * \brief Les 4 octets par lesquels commence un enregistrement.
+ */
+constexpr char MAGIC[] {'G', 'J', 'T', 'R'};
+
+/*!
+ * \brief Méthode écrivant un entier de taille variable, 7 bits par octet.
+ * \param out les octets
+ * \param value l'entier
+ */
+void put(std::vector<std::uint8_t> & out, std::uint64_t value){
+    while(value >= 0x80){
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/*!
+ * \brief Méthode écrivant un entier signé de taille variable.
+ *
+ * Le signe est rangé dans le bit de poids faible : les petites valeurs
+ * négatives tiennent en un octet.
+ *
+ * \param out les octets
+ * \param value l'entier
+ */
+void putSigned(std::vector<std::uint8_t> & out, std::int64_t value){
+    put(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+/*!
+ * \brief Méthode lisant un entier écrit par \ref put.
+ *
+ * \param in les octets
+ * \param size le nombre d'octets
+ * \param position la position de l'entier, avancée au-delà
+ * \param max la plus grande valeur acceptée
+ * \return l'entier
+ * \throw std::invalid_argument si les octets sont tronqués ou l'entier trop grand
+ */
+std::uint64_t get(const std::uint8_t * in, std::size_t size, std::size_t & position,
+                  std::uint64_t max = ~std::uint64_t(0)){
+    std::uint64_t value {0};
+    for(unsigned shift {0}; shift < 64; shift += 7){
+        if(position >= size){
+            throw std::invalid_argument("enregistrement tronqué");
+        }
+        std::uint8_t byte {in[position++]};
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if(!(byte & 0x80)){
+            if(value > max){
+                throw std::invalid_argument("valeur non valide dans l'enregistrement");
+            }
+            return value;
+        }
+    }
+    throw std::invalid_argument("entier trop long dans l'enregistrement");
+}
+
+/*!
+ * \brief Méthode lisant un entier signé écrit par \ref putSigned.
+ *
+ * \param in les octets
+ * \param size le nombre d'octets
+ * \param position la position de l'entier, avancée au-delà
+ * \param limit la plus grande valeur absolue acceptée
+ * \return l'entier
+ * \throw std::invalid_argument si les octets sont tronqués ou l'entier trop grand
+ */
+std::int64_t getSigned(const std::uint8_t * in, std::size_t size, std::size_t & position, std::uint64_t limit){
+    std::uint64_t value {get(in, size, position, 2 * limit)};
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace
+
+Replay::Replay(): header_{}, ticks_{0}, checkTicks_{0}, result_{}, finished_{1}{
+}
+
+void Replay::begin(ReplayHeader header){
+    header_ = std::move(header);
+    events_.clear();
+    ticks_ = 0;
+    checkTicks_ = 0;
+    result_ = ReplayResult{};
+    finished_ = 0;
+}
+
+void Replay::record(Input input){
+    if(finished_){
+        return;
+    }
+    if(input == Input::NONE){
+        ++ticks_;
+    } else{
+        push(static_cast<unsigned>(input));
+    }
+}
+
+void Replay::recordLines(const std::vector<int> & line){
+    if(finished_){
+        return;
+    }
+    push(LINES);
+    put(events_, line.size());
+    for(int x : line){
+        put(events_, static_cast<std::uint64_t>(x + 1));
+    }
+}
+
+void Replay::recordTimeOut(){
+    if(!finished_){
+        push(TIME_OUT);
+    }
+}
+
+void Replay::check(std::uint16_t checksum){
+    if(finished_ || ++checkTicks_ < CHECK_INTERVAL){
+        return;
+    }
+    push(CHECK);
+    put(events_, checksum);
+    checkTicks_ = 0;
+}
+
+void Replay::finish(const ReplayResult & result){
+    if(!finished_){
+        result_ = result;
+        finished_ = 1;
+    }
+}
+
+const ReplayHeader & Replay::getHeader() const{
+    return header_;
+}
+
+const ReplayResult & Replay::getResult() const{
+    if(!finished_){
+        throw std::logic_error("l'enregistrement n'est pas terminé");
+    }
+    return result_;
+}
+
+bool Replay::isFinished() const{
+    return finished_;
+}
+
+std::size_t Replay::getSize() const{
+    return events_.size();
+}
+
+void Replay::push(unsigned code){
+    put(events_, std::uint64_t(ticks_) << CODE_BITS | code);
+    ticks_ = 0;
+}
+
+std::vector<std::uint8_t> Replay::encode(std::size_t & events) const{
+    if(!finished_ || header_.brics.empty()){
+        throw std::logic_error("aucune partie terminée n'a été enregistrée");
+    }
+    std::vector<std::uint8_t> bytes(std::begin(MAGIC), std::end(MAGIC));
+    put(bytes, VERSION);
+    put(bytes, header_.name.size());
+    bytes.insert(bytes.end(), header_.name.begin(), header_.name.end());
+    put(bytes, header_.width);
+    put(bytes, header_.height);
+    put(bytes, header_.winScore);
+    put(bytes, header_.winLines);
+    put(bytes, header_.winTime);
+    put(bytes, header_.level);
+    put(bytes, header_.winByScore | header_.winByLines << 1 | header_.winByTime << 2);
+    put(bytes, header_.seed);
+    put(bytes, static_cast<unsigned>(header_.policy));
+    put(bytes, header_.brics.size());
+    for(const Bric & bric : header_.brics){
+        put(bytes, bric.color_.getCode());
+        putSigned(bytes, static_cast<int>(bric.middle_.getX()));
+        putSigned(bytes, static_cast<int>(bric.middle_.getY()));
+        put(bytes, bric.side_);
+        put(bytes, bric.rotation_);
+        for(const Bric::Orientation & o : bric.orientations_){
+            putSigned(bytes, o.left);
+            putSigned(bytes, o.top);
+            put(bytes, o.width);
+            put(bytes, o.height);
+            for(unsigned v {0}; v < o.height; ++v){
+                put(bytes, o.rows[v]);
+            }
+        }
+    }
+    events = bytes.size();
+    bytes.insert(bytes.end(), events_.begin(), events_.end());
+    put(bytes, std::uint64_t(ticks_) << CODE_BITS | END);
+    put(bytes, result_.hash);
+    put(bytes, result_.score);
+    put(bytes, result_.lines);
+    put(bytes, result_.gameState);
+    return bytes;
+}
+
+void Replay::save(std::ostream & out) const{
+    std::size_t events;
+    const std::vector<std::uint8_t> bytes {encode(events)};
+    out.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
+
+Replay Replay::load(std::istream & in){
+    const std::vector<std::uint8_t> bytes {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    return decode(bytes.data(), bytes.size());
+}
+
+ReplayHeader Replay::decodeHeader(const std::uint8_t * data, std::size_t size, std::size_t & position){
+    if(size < sizeof(MAGIC) || !std::equal(std::begin(MAGIC), std::end(MAGIC), data)){
+        throw std::invalid_argument("ce fichier n'est pas un enregistrement de partie");
+    }
+    position = sizeof(MAGIC);
+    if(get(data, size, position) != VERSION){
+        throw std::invalid_argument("version d'enregistrement non prise en charge");
+    }
+    ReplayHeader header;
+    std::size_t length = get(data, size, position, size - position);
+    header.name.assign(data + position, data + position + length);
+    position += length;
+    header.width = get(data, size, position, Board::MAXIMUM_WIDTH);
+    header.height = get(data, size, position, Board::MAXIMUM_HEIGHT);
+    header.winScore = get(data, size, position, UINT32_MAX);
+    header.winLines = get(data, size, position, UINT32_MAX);
+    header.winTime = get(data, size, position, UINT32_MAX);
+    header.level = get(data, size, position, UINT32_MAX);
+    unsigned wins = get(data, size, position, 7);
+    header.winByScore = wins & 1;
+    header.winByLines = wins & 2;
+    header.winByTime = wins & 4;
+    header.seed = get(data, size, position);
+    header.policy = static_cast<BagPolicy>(get(data, size, position, static_cast<unsigned>(BagPolicy::HISTORY)));
+    std::size_t count = get(data, size, position, BricsBag::MAXIMUM_BRICS);
+    if(count == 0){
+        throw std::invalid_argument("le sac enregistré est vide");
+    }
+    for(std::size_t i {0}; i < count; ++i){
+        Bric bric;
+        std::uint32_t code = get(data, size, position, 0xFFFFFF);
+        bric.color_ = Color(code >> 16, (code >> 8) & 0xFF, code & 0xFF);
+        int x = getSigned(data, size, position, Bric::MAXIMUM_SIDE);
+        int y = getSigned(data, size, position, Bric::MAXIMUM_SIDE);
+        bric.middle_ = Position(static_cast<unsigned>(x), static_cast<unsigned>(y));
+        bric.side_ = get(data, size, position, Bric::MAXIMUM_SIDE);
+        bric.rotation_ = get(data, size, position, Bric::ORIENTATIONS - 1);
+        for(Bric::Orientation & o : bric.orientations_){
+            o.left = getSigned(data, size, position, Bric::MAXIMUM_SIDE);
+            o.top = getSigned(data, size, position, Bric::MAXIMUM_SIDE);
+            o.width = get(data, size, position, Bric::MAXIMUM_SIDE);
+            o.height = get(data, size, position, Bric::MAXIMUM_SIDE);
+            o.rows.fill(0);
+            for(unsigned v {0}; v < o.height; ++v){
+                o.rows[v] = get(data, size, position, (1u << o.width) - 1);
+            }
+        }
+        header.brics.push_back(bric);
+    }
+    return header;
+}
+
+Replay Replay::decode(const std::uint8_t * data, std::size_t size){
+    Replay replay;
+    std::size_t position;
+    replay.header_ = decodeHeader(data, size, position);
+    const std::size_t events {position};
+    for(;;){
+        const std::size_t start {position};
+        std::uint64_t event {get(data, size, position)};
+        unsigned code = event & ((1u << CODE_BITS) - 1);
+        if(event >> CODE_BITS > UINT32_MAX){
+            throw std::invalid_argument("nombre de descentes non valide dans l'enregistrement");
+        }
+        if(code == END){
+            replay.events_.assign(data + events, data + start);
+            replay.ticks_ = event >> CODE_BITS;
+            break;
+        } else if(code == CHECK){
+            get(data, size, position, UINT16_MAX);
+        } else if(code == LINES){
+            std::size_t count = get(data, size, position, (Board::MAXIMUM_WIDTH + 1) * Board::MAXIMUM_HEIGHT);
+            std::uint64_t x {0};
+            for(std::size_t u {0}; u < count; ++u){
+                x = get(data, size, position, replay.header_.width);
+            }
+            if(x != 0){
+                throw std::invalid_argument("ligne non terminée dans l'enregistrement");
+            }
+        } else if(code > TIME_OUT){
+            throw std::invalid_argument("action non valide dans l'enregistrement");
+        }
+    }
+    replay.result_.hash = get(data, size, position);
+    replay.result_.score = get(data, size, position, UINT32_MAX);
+    replay.result_.lines = get(data, size, position, UINT32_MAX);
+    replay.result_.gameState = static_cast<GameState>(get(data, size, position, GameState::OTHER_LINE));
+    if(position != size){
+        throw std::invalid_argument("données en trop à la fin de l'enregistrement");
+    }
+    replay.finished_ = 1;
+    return replay;
+}
+
+void Replay::start(Simulation & game) const{
+    start(header_, game);
+}
+
+void Replay::start(const ReplayHeader & header, Simulation & game){
+    game.setBag(header.brics, false);
+    game.setBagPolicy(header.policy);
+    game.initGame(header.name, header.width, header.height, header.winScore, header.winLines,
+                  header.winTime, header.level, header.winByScore, header.winByLines, header.winByTime);
+    game.setSeed(header.seed);
+    game.startGame();
+}
+
+ReplayPlayer::ReplayPlayer(const Replay & replay):
+    ReplayPlayer(replay.events_.data(), replay.events_.size(), replay.ticks_){
+}
+
+ReplayPlayer::ReplayPlayer(const std::uint8_t * events, std::size_t size, unsigned last):
+    events_{events}, size_{size}, last_{last}, position_{0}, tick_{0}, checked_{0}, divergence_{0}, diverged_{0}{
+    next();
+}
+
+bool ReplayPlayer::tick(Simulation & game){
+    while(ticks_ == 0){
+        if(code_ == END){
+            return false;
+        }
+        if(code_ == LINES){
+            std::vector<int> line(get(events_, size_, position_, (Board::MAXIMUM_WIDTH + 1) * Board::MAXIMUM_HEIGHT));
+            for(int & x : line){
+                x = static_cast<int>(get(events_, size_, position_)) - 1;
+            }
+            game.addLine(line);
+        } else if(code_ == TIME_OUT){
+            game.timeOut();
+        } else if(code_ == CHECK){
+            std::uint64_t checksum {get(events_, size_, position_)};
+            if(!diverged_){
+                if(checksum == game.getChecksum()){
+                    checked_ = tick_;
+                } else{
+                    diverged_ = 1;
+                    divergence_ = tick_;
+                }
+            }
+        } else{
+            game.step(static_cast<Input>(code_));
+        }
+        next();
+    }
+    game.step(Input::NONE);
+    --ticks_;
+    ++tick_;
+    return true;
+}
+
+void ReplayPlayer::run(Simulation & game){
+    while(tick(game)){
+    }
+}
+
+void ReplayPlayer::next(){
+    if(position_ < size_){
+        std::uint64_t event {get(events_, size_, position_)};
+        ticks_ = event >> CODE_BITS;
+        code_ = event & ((1u << CODE_BITS) - 1);
+    } else{
+        ticks_ = last_;
+        code_ = END;
+    }
+}
@@ -0,0 +1,416 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "bric.h"
+#include "bagpolicy.h"
+#include "gamestate.h"
+#include "input.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+class Simulation;
+
+/*!
+ * \brief Structure décrivant la configuration d'une partie enregistrée.
+ *
+ * Elle contient tout ce qui, avec les actions, détermine la partie :
+ * les paramètres de \ref Simulation::initGame, la graine, la politique et
+ * le contenu du sac.
+ */
+struct ReplayHeader{
+    std::string name;
+    /*!< Le nom du joueur. */
+
+    unsigned width;
+    /*!< La largeur de la grille. */
+
+    unsigned height;
+    /*!< La hauteur de la grille. */
+
+    unsigned winScore;
+    /*!< Le score de victoire. */
+
+    unsigned winLines;
+    /*!< Le nombre de lignes de victoire. */
+
+    unsigned winTime;
+    /*!< Le temps de victoire. */
+
+    unsigned level;
+    /*!< Le niveau de difficulté de départ. */
+
+    bool winByScore;
+    /*!< La victoire par score est-elle activée. */
+
+    bool winByLines;
+    /*!< La victoire par lignes est-elle activée. */
+
+    bool winByTime;
+    /*!< La victoire par temps est-elle activée. */
+
+    std::uint64_t seed;
+    /*!< La graine du sac. */
+
+    BagPolicy policy;
+    /*!< La manière de tirer les briques du sac. */
+
+    std::vector<Bric> brics;
+    /*!< Les briques du sac. */
+};
+
+/*!
+ * \brief Structure décrivant la fin d'une partie enregistrée.
+ *
+ * Elle permet de vérifier qu'une partie rejouée donne le même résultat.
+ */
+struct ReplayResult{
+    std::uint64_t hash;
+    /*!< La clé de \ref Zobrist de la grille. */
+
+    unsigned score;
+    /*!< Le score du joueur. */
+
+    unsigned lines;
+    /*!< Le nombre de lignes remplies. */
+
+    GameState gameState;
+    /*!< L'état de la partie. */
+};
+
+/*!
+ * \brief Classe représentant l'enregistrement d'une partie.
+ *
+ * Une partie ne dépendant que de sa configuration, des actions reçues par
+ * \ref Simulation::step et \ref Simulation::addLine et de la fin du temps
+ * signalée par \ref Simulation::timeOut, l'enregistrement se limite
+ * à un \ref ReplayHeader et à la suite de ces actions. Les descentes
+ * automatiques ne sont que comptées : chaque autre action est rangée avec
+ * le nombre de descentes qui la précèdent.
+ *
+ * Les actions sont codées au fur et à mesure sous forme d'entiers de taille
+ * variable : une action tient le plus souvent en un octet et une partie
+ * complète en quelques kilo-octets.
+ *
+ * Toutes les \ref CHECK_INTERVAL descentes, un point de contrôle range
+ * l'empreinte de l'état du jeu : une partie rejouée qui s'écarte de
+ * l'originale est ainsi repérée à \ref CHECK_INTERVAL descentes près.
+ */
+class Replay{
+    friend class ReplayPlayer;
+    friend class ReplayArchive;
+    friend class ReplayArchiveWriter;
+
+public:
+    constexpr static unsigned VERSION {2};
+    /*!< La version du format binaire écrit par \ref save. */
+
+    constexpr static unsigned CHECK_INTERVAL {8};
+    /*!< Le nombre de descentes automatiques entre deux points de contrôle. */
+
+private:
+    ReplayHeader header_;
+    /*!< La configuration de la partie. */
+
+    std::vector<std::uint8_t> events_;
+    /*!< Les actions codées, chacune précédée du nombre de descentes automatiques
+     * depuis l'action précédente. */
+
+    unsigned ticks_;
+    /*!< Le nombre de descentes automatiques depuis la dernière action. */
+
+    unsigned checkTicks_;
+    /*!< Le nombre de descentes automatiques depuis le dernier point de contrôle. */
+
+    ReplayResult result_;
+    /*!< La fin de la partie, valide si \ref finished_ est vrai. */
+
+    bool finished_;
+    /*!< L'enregistrement est-il terminé. */
+
+public:
+    /*!
+     * \brief Constructeur sans argument de \ref Replay.
+     *
+     * Il crée un enregistrement vide.
+     */
+    Replay();
+
+    /*!
+     * \brief Méthode commençant l'enregistrement d'une nouvelle partie.
+     *
+     * Les actions précédemment enregistrées sont oubliées.
+     *
+     * \param header la configuration de la partie
+     */
+    void begin(ReplayHeader header);
+
+    /*!
+     * \brief Méthode enregistrant une action appliquée par \ref Simulation::step.
+     * \param input l'action
+     */
+    void record(Input input);
+
+    /*!
+     * \brief Méthode enregistrant des lignes ajoutées par \ref Simulation::addLine.
+     * \param line les abscisses des cases pleines de chaque ligne, chaque ligne étant terminée par -1
+     */
+    void recordLines(const std::vector<int> & line);
+
+    /*!
+     * \brief Méthode enregistrant la fin du temps signalée par \ref Simulation::timeOut.
+     */
+    void recordTimeOut();
+
+    /*!
+     * \brief Méthode appelée après chaque descente automatique, enregistrant
+     * un point de contrôle toutes les \ref CHECK_INTERVAL descentes.
+     *
+     * \param checksum l'empreinte de l'état du jeu, donnée par \ref Simulation::getChecksum
+     */
+    void check(std::uint16_t checksum);
+
+    /*!
+     * \brief Méthode terminant l'enregistrement.
+     * \param result la fin de la partie
+     */
+    void finish(const ReplayResult & result);
+
+    /*!
+     * \brief Accesseur en lecture de la configuration de la partie.
+     * \return la configuration
+     */
+    const ReplayHeader & getHeader() const;
+
+    /*!
+     * \brief Accesseur en lecture de la fin de la partie.
+     * \return la fin de la partie
+     * \throw std::logic_error si l'enregistrement n'est pas terminé
+     */
+    const ReplayResult & getResult() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'état de l'enregistrement.
+     * \return true si l'enregistrement est terminé, false sinon
+     */
+    bool isFinished() const;
+
+    /*!
+     * \brief Accesseur en lecture de la taille des actions codées.
+     * \return le nombre d'octets des actions
+     */
+    std::size_t getSize() const;
+
+    /*!
+     * \brief Méthode écrivant l'enregistrement terminé dans un flux binaire.
+     *
+     * \param out le flux, ouvert en mode binaire
+     * \throw std::logic_error si l'enregistrement n'est pas terminé
+     */
+    void save(std::ostream & out) const;
+
+    /*!
+     * \brief Méthode lisant un enregistrement écrit par \ref save.
+     *
+     * Toutes les actions sont vérifiées : un \ref ReplayPlayer peut ensuite
+     * les rejouer sans contrôle.
+     *
+     * \param in le flux, ouvert en mode binaire
+     * \return l'enregistrement
+     * \throw std::invalid_argument si le flux n'est pas un enregistrement valide
+     */
+    static Replay load(std::istream & in);
+
+    /*!
+     * \brief Méthode préparant une \ref Simulation à rejouer la partie.
+     *
+     * Le sac, sa politique et sa graine sont remplacés, puis la partie
+     * est initialisée et lancée.
+     *
+     * \param game la partie
+     */
+    void start(Simulation & game) const;
+
+private:
+    /*!
+     * \brief Méthode codant une action et le nombre de descentes qui la précèdent.
+     * \param code le code de l'action
+     */
+    void push(unsigned code);
+
+    /*!
+     * \brief Méthode codant l'enregistrement terminé dans le format de \ref save.
+     *
+     * \param events la position des actions dans les octets
+     * \return les octets
+     * \throw std::logic_error si l'enregistrement n'est pas terminé
+     */
+    std::vector<std::uint8_t> encode(std::size_t & events) const;
+
+    /*!
+     * \brief Méthode décodant un enregistrement écrit par \ref save.
+     *
+     * \param data les octets
+     * \param size le nombre d'octets
+     * \return l'enregistrement
+     * \throw std::invalid_argument si les octets ne sont pas un enregistrement valide
+     */
+    static Replay decode(const std::uint8_t * data, std::size_t size);
+
+    /*!
+     * \brief Méthode décodant la configuration au début d'un enregistrement.
+     *
+     * \param data les octets
+     * \param size le nombre d'octets
+     * \param position la position des actions, qui suivent la configuration
+     * \return la configuration
+     * \throw std::invalid_argument si la configuration n'est pas valide
+     */
+    static ReplayHeader decodeHeader(const std::uint8_t * data, std::size_t size, std::size_t & position);
+
+    /*!
+     * \brief Méthode préparant une \ref Simulation à rejouer une partie.
+     * \param header la configuration de la partie
+     * \param game la partie
+     */
+    static void start(const ReplayHeader & header, Simulation & game);
+};
+
+/*!
+ * \brief Classe rejouant un \ref Replay dans une \ref Simulation.
+ *
+ * Elle avance descente automatique par descente automatique : appelée au
+ * rythme de \ref Simulation::getInterval, elle montre la partie en temps réel ;
+ * appelée en boucle par \ref run, elle la rejoue aussi vite que le processeur
+ * le permet.
+ *
+ * Les actions ne sont pas copiées : l'enregistrement, ou l'archive dont
+ * elles proviennent, doit rester en vie tant qu'il est rejoué.
+ */
+class ReplayPlayer{
+    friend class ReplayArchive;
+    friend class ReplayArchiveWriter;
+
+    const std::uint8_t * events_;
+    /*!< Les actions codées. */
+
+    std::size_t size_;
+    /*!< Le nombre d'octets des actions. */
+
+    unsigned last_;
+    /*!< Le nombre de descentes automatiques après la dernière action. */
+
+    std::size_t position_;
+    /*!< La position de la prochaine action dans les actions codées. */
+
+    unsigned ticks_;
+    /*!< Le nombre de descentes automatiques avant la prochaine action. */
+
+    unsigned code_;
+    /*!< Le code de la prochaine action. */
+
+    std::uint64_t tick_;
+    /*!< Le nombre de descentes automatiques rejouées. */
+
+    std::uint64_t checked_;
+    /*!< La descente du dernier point de contrôle vérifié avant tout écart. */
+
+    std::uint64_t divergence_;
+    /*!< La descente du premier point de contrôle en écart, valide si \ref diverged_ est vrai. */
+
+    bool diverged_;
+    /*!< Un point de contrôle a-t-il été trouvé en écart. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref ReplayPlayer.
+     * \param replay l'enregistrement à rejouer
+     */
+    explicit ReplayPlayer(const Replay & replay);
+
+    /*!
+     * \brief Méthode rejouant les actions jusqu'à la prochaine descente automatique comprise.
+     *
+     * \param game la partie, préparée par \ref Replay::start
+     * \return false si l'enregistrement est fini, true sinon
+     * \throw std::invalid_argument si les actions d'une archive sont corrompues
+     */
+    bool tick(Simulation & game);
+
+    /*!
+     * \brief Méthode rejouant toute la fin de la partie sans attendre.
+     * \param game la partie, préparée par \ref Replay::start
+     */
+    void run(Simulation & game);
+
+    /*!
+     * \brief Accesseur en lecture du nombre de descentes automatiques rejouées.
+     * \return le nombre de descentes
+     */
+    inline std::uint64_t getTick() const;
+
+    /*!
+     * \brief Méthode vérifiant si la partie rejouée s'est écartée de l'originale.
+     * \return true si un point de contrôle rejoué ne correspond pas à l'enregistrement, false sinon
+     */
+    inline bool hasDiverged() const;
+
+    /*!
+     * \brief Accesseur en lecture de la descente du premier point de contrôle en écart.
+     *
+     * L'écart est apparu entre \ref getLastCheck et cette descente.
+     *
+     * \return la descente, valide si \ref hasDiverged est vrai
+     */
+    inline std::uint64_t getDivergence() const;
+
+    /*!
+     * \brief Accesseur en lecture de la descente du dernier point de contrôle
+     * vérifié avant tout écart.
+     * \return la descente, 0 si aucun point de contrôle n'a été vérifié
+     */
+    inline std::uint64_t getLastCheck() const;
+
+private:
+    /*!
+     * \brief Constructeur de \ref ReplayPlayer à partir d'actions codées.
+     *
+     * \param events les actions codées
+     * \param size le nombre d'octets des actions
+     * \param last le nombre de descentes automatiques après la dernière action
+     */
+    ReplayPlayer(const std::uint8_t * events, std::size_t size, unsigned last);
+
+    /*!
+     * \brief Méthode décodant la prochaine action.
+     */
+    void next();
+};
+
+//méthodes inline
+std::uint64_t ReplayPlayer::getTick() const{
+    return tick_;
+}
+
+bool ReplayPlayer::hasDiverged() const{
+    return diverged_;
+}
+
+std::uint64_t ReplayPlayer::getDivergence() const{
+    return divergence_;
+}
+
+std::uint64_t ReplayPlayer::getLastCheck() const{
+    return checked_;
+}
+
+} // namespace GJ_GW
+
+#endif // REPLAY_H
@@ -0,0 +1,246 @@
+#include "replayarchive.h"
+#include "simulation.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief La version du format écrit par \ref ReplayArchiveWriter.
+ */
+constexpr std::uint32_t VERSION {2};
+
+/*!
+ * \brief Les 4 octets par lesquels commence et finit une archive.
+ */
+constexpr char MAGIC[] {'G', 'J', 'T', 'A'};
+
+/*!
+ * \brief La taille de l'en-tête de l'archive : \ref MAGIC et \ref VERSION.
+ */
+constexpr std::uint64_t HEADER_SIZE {8};
+
+/*!
+ * \brief Valeur écrite telle quelle dans le pied de l'archive, pour en reconnaître le boutisme.
+ */
+constexpr std::uint32_t ENDIANNESS {0x01020304};
+
+/*!
+ * \brief Structure terminant une archive.
+ */
+struct ArchiveFooter{
+    std::uint64_t entries;
+    /*!< La position de l'index. */
+
+    std::uint64_t count;
+    /*!< Le nombre de parties. */
+
+    std::uint32_t entrySize;
+    /*!< La taille d'une \ref ArchiveEntry. */
+
+    std::uint32_t keyframeSize;
+    /*!< La taille d'une \ref ArchiveKeyframe. */
+
+    std::uint32_t byteOrder;
+    /*!< \ref ENDIANNESS, dans le boutisme de la machine qui a écrit l'archive. */
+
+    std::uint32_t version;
+    /*!< La version du format. */
+
+    char magic[8];
+    /*!< \ref MAGIC, suivi de zéros. */
+};
+
+/*!
+ * \brief Méthode vérifiant qu'une zone tient entre le début de l'archive et une limite.
+ *
+ * \param begin le début de la zone
+ * \param size la taille de la zone
+ * \param limit la limite
+ * \return true si la zone tient avant la limite, false sinon
+ */
+bool inside(std::uint64_t begin, std::uint64_t size, std::uint64_t limit){
+    return begin <= limit && size <= limit - begin;
+}
+
+} // namespace
+
+ReplayArchiveWriter::ReplayArchiveWriter(const std::string & path, unsigned interval):
+    path_{path}, offset_{0}, interval_{interval}, closed_{0}{
+    if(interval_ == 0){
+        throw std::invalid_argument("l'intervalle entre deux images clés doit être positif");
+    }
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if(!out_){
+        throw std::invalid_argument("impossible de créer l'archive " + path);
+    }
+    write(MAGIC, sizeof(MAGIC));
+    write(&VERSION, sizeof(VERSION));
+}
+
+ReplayArchiveWriter::~ReplayArchiveWriter(){
+    try{
+        close();
+    } catch(const std::exception &){
+        // un destructeur ne peut pas signaler l'erreur : l'archive restera illisible
+    }
+}
+
+void ReplayArchiveWriter::add(const Replay & replay){
+    if(closed_){
+        throw std::logic_error("l'archive " + path_ + " est fermée");
+    }
+    std::size_t events;
+    const std::vector<std::uint8_t> bytes {replay.encode(events)};
+    ArchiveEntry entry {};
+    entry.offset = offset_;
+    entry.size = bytes.size();
+    entry.events = offset_ + events;
+    entry.eventsSize = replay.events_.size();
+    entry.seed = replay.header_.seed;
+    entry.hash = replay.result_.hash;
+    entry.last = replay.ticks_;
+    entry.width = replay.header_.width;
+    entry.height = replay.header_.height;
+    entry.score = replay.result_.score;
+    entry.lines = replay.result_.lines;
+    entry.gameState = replay.result_.gameState;
+    write(bytes.data(), bytes.size());
+    align();
+
+    entry.keyframes = offset_;
+    Simulation game;
+    Replay::start(replay.header_, game);
+    ReplayPlayer player {replay};
+    ArchiveKeyframe keyframe {};
+    std::uint64_t tick {0};
+    for(;;){
+        if(tick % interval_ == 0){
+            keyframe.tick = tick;
+            keyframe.position = player.position_;
+            keyframe.ticks = player.ticks_;
+            keyframe.code = player.code_;
+            keyframe.snapshot = game.capture();
+            write(&keyframe, sizeof(keyframe));
+            ++entry.keyframeCount;
+        }
+        if(!player.tick(game)){
+            break;
+        }
+        ++tick;
+    }
+    entry.ticks = tick;
+    entries_.push_back(entry);
+}
+
+void ReplayArchiveWriter::close(){
+    if(closed_){
+        return;
+    }
+    closed_ = 1;
+    ArchiveFooter footer {};
+    footer.entries = offset_;
+    footer.count = entries_.size();
+    footer.entrySize = sizeof(ArchiveEntry);
+    footer.keyframeSize = sizeof(ArchiveKeyframe);
+    footer.byteOrder = ENDIANNESS;
+    footer.version = VERSION;
+    std::copy(std::begin(MAGIC), std::end(MAGIC), footer.magic);
+    write(entries_.data(), entries_.size() * sizeof(ArchiveEntry));
+    write(&footer, sizeof(footer));
+    out_.close();
+    if(!out_){
+        throw std::invalid_argument("impossible d'écrire l'archive " + path_);
+    }
+}
+
+void ReplayArchiveWriter::write(const void * data, std::size_t size){
+    out_.write(static_cast<const char *>(data), size);
+    if(!out_){
+        throw std::invalid_argument("impossible d'écrire l'archive " + path_);
+    }
+    offset_ += size;
+}
+
+void ReplayArchiveWriter::align(){
+    constexpr char zeros[8] {};
+    write(zeros, (8 - offset_ % 8) % 8);
+}
+
+ReplayArchive::ReplayArchive(const std::string & path): file_{path}, entries_{nullptr}, size_{0}{
+    const std::uint8_t * data {file_.getData()};
+    const std::uint64_t size {file_.getSize()};
+    ArchiveFooter footer;
+    if(size < HEADER_SIZE + sizeof(footer) || !std::equal(std::begin(MAGIC), std::end(MAGIC), data)){
+        throw std::invalid_argument(path + " n'est pas une archive d'enregistrements");
+    }
+    std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+    if(!std::equal(std::begin(MAGIC), std::end(MAGIC), footer.magic)){
+        throw std::invalid_argument("l'archive " + path + " est tronquée");
+    }
+    if(footer.byteOrder != ENDIANNESS || footer.version != VERSION
+            || footer.entrySize != sizeof(ArchiveEntry) || footer.keyframeSize != sizeof(ArchiveKeyframe)){
+        throw std::invalid_argument("l'archive " + path + " a été écrite par une autre version ou une autre machine");
+    }
+    const std::uint64_t end {size - sizeof(footer)};
+    if(footer.entries < HEADER_SIZE || footer.entries % 8 != 0 || !inside(footer.entries, 0, end)
+            || footer.count != (end - footer.entries) / sizeof(ArchiveEntry)
+            || (end - footer.entries) % sizeof(ArchiveEntry) != 0){
+        throw std::invalid_argument("l'index de l'archive " + path + " est corrompu");
+    }
+    entries_ = reinterpret_cast<const ArchiveEntry *>(data + footer.entries);
+    size_ = footer.count;
+    for(std::size_t i {0}; i < size_; ++i){
+        const ArchiveEntry & entry {entries_[i]};
+        if(entry.offset < HEADER_SIZE || !inside(entry.offset, entry.size, footer.entries)
+                || entry.events < entry.offset || !inside(entry.events, entry.eventsSize, entry.offset + entry.size)
+                || entry.keyframes % 8 != 0 || entry.keyframeCount == 0
+                || !inside(entry.keyframes, std::uint64_t(entry.keyframeCount) * sizeof(ArchiveKeyframe), footer.entries)){
+            throw std::invalid_argument("la partie " + std::to_string(i) + " de l'archive " + path + " est corrompue");
+        }
+    }
+}
+
+const ArchiveEntry & ReplayArchive::getEntry(std::size_t game) const{
+    if(game >= size_){
+        throw std::out_of_range("l'archive ne contient que " + std::to_string(size_) + " parties");
+    }
+    return entries_[game];
+}
+
+ReplayHeader ReplayArchive::getHeader(std::size_t game) const{
+    const ArchiveEntry & entry {getEntry(game)};
+    std::size_t position;
+    return Replay::decodeHeader(file_.getData() + entry.offset, entry.size, position);
+}
+
+Replay ReplayArchive::getReplay(std::size_t game) const{
+    const ArchiveEntry & entry {getEntry(game)};
+    return Replay::decode(file_.getData() + entry.offset, entry.size);
+}
+
+ReplayPlayer ReplayArchive::seek(std::size_t game, std::uint64_t tick, Simulation & simulation) const{
+    const ArchiveEntry & entry {getEntry(game)};
+    Replay::start(getHeader(game), simulation);
+    const ArchiveKeyframe * first {reinterpret_cast<const ArchiveKeyframe *>(file_.getData() + entry.keyframes)};
+    const ArchiveKeyframe * keyframe {std::upper_bound(first + 1, first + entry.keyframeCount, tick,
+                                                       [](std::uint64_t t, const ArchiveKeyframe & k){
+                                                           return t < k.tick;
+                                                       }) - 1};
+    if(keyframe->tick > tick){
+        throw std::invalid_argument("image clé corrompue dans la partie " + std::to_string(game) + " de l'archive");
+    }
+    // restore refuse toute image clé dont la grille, le sac ou la brique courante sont incohérents
+    simulation.restore(keyframe->snapshot);
+    ReplayPlayer player {file_.getData() + entry.events, static_cast<std::size_t>(entry.eventsSize), entry.last};
+    player.position_ = keyframe->position;
+    player.ticks_ = keyframe->ticks;
+    player.code_ = keyframe->code;
+    player.tick_ = keyframe->tick;
+    for(std::uint64_t t {keyframe->tick}; t < tick && player.tick(simulation); ++t){
+    }
+    return player;
+}
@@ -0,0 +1,305 @@
+#ifndef REPLAYARCHIVE_H
+#define REPLAYARCHIVE_H
+
+#include "gamesnapshot.h"
+#include "mappedfile.h"
+#include "replay.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure décrivant une partie dans l'index d'une archive d'enregistrements.
+ *
+ * Elle suffit aux analyses qui ne s'intéressent qu'au résultat des parties :
+ * parcourir l'index ne lit aucune action.
+ */
+struct ArchiveEntry{
+    std::uint64_t offset;
+    /*!< La position de l'enregistrement dans l'archive. */
+
+    std::uint64_t size;
+    /*!< La taille de l'enregistrement, au format de \ref Replay::save. */
+
+    std::uint64_t events;
+    /*!< La position des actions codées dans l'archive. */
+
+    std::uint64_t eventsSize;
+    /*!< Le nombre d'octets des actions codées. */
+
+    std::uint64_t keyframes;
+    /*!< La position des images clés de la partie dans l'archive. */
+
+    std::uint64_t ticks;
+    /*!< Le nombre total de descentes automatiques de la partie. */
+
+    std::uint64_t seed;
+    /*!< La graine du sac. */
+
+    std::uint64_t hash;
+    /*!< La clé de \ref Zobrist de la grille à la fin de la partie. */
+
+    std::uint32_t keyframeCount;
+    /*!< Le nombre d'images clés de la partie, au moins 1. */
+
+    std::uint32_t last;
+    /*!< Le nombre de descentes automatiques après la dernière action. */
+
+    std::uint32_t width;
+    /*!< La largeur de la grille. */
+
+    std::uint32_t height;
+    /*!< La hauteur de la grille. */
+
+    std::uint32_t score;
+    /*!< Le score final du joueur. */
+
+    std::uint32_t lines;
+    /*!< Le nombre de lignes remplies. */
+
+    std::uint32_t gameState;
+    /*!< L'état de la partie à la fin de l'enregistrement. */
+
+    std::uint32_t reserved;
+    /*!< Inutilisé, toujours 0. */
+};
+
+/*!
+ * \brief Structure représentant une image clé : l'état complet d'une partie
+ * et la position du \ref ReplayPlayer après un nombre donné de descentes.
+ */
+struct ArchiveKeyframe{
+    std::uint64_t tick;
+    /*!< Le nombre de descentes automatiques rejouées. */
+
+    std::uint64_t position;
+    /*!< La position dans les actions codées après la prochaine action. */
+
+    std::uint32_t ticks;
+    /*!< Le nombre de descentes automatiques avant la prochaine action. */
+
+    std::uint32_t code;
+    /*!< Le code de la prochaine action. */
+
+    GameSnapshot snapshot;
+    /*!< L'état de la partie. */
+};
+
+static_assert(std::is_trivially_copyable<ArchiveEntry>::value && std::is_standard_layout<ArchiveEntry>::value
+              && std::is_trivially_copyable<ArchiveKeyframe>::value && std::is_standard_layout<ArchiveKeyframe>::value,
+              "l'index d'une archive doit pouvoir être lu sur place");
+
+/*!
+ * \brief Classe écrivant une archive d'enregistrements de parties.
+ *
+ * Une archive est un seul fichier contenant :
+ * - les enregistrements, chacun au format de \ref Replay::save et suivi
+ *   des images clés de sa partie ;
+ * - l'index des parties, une \ref ArchiveEntry par partie ;
+ * - un pied de fichier donnant la position de l'index.
+ *
+ * Les images clés sont prises toutes les \ref getInterval descentes
+ * automatiques, en rejouant chaque partie au moment de l'ajouter.
+ *
+ * L'index et les images clés sont écrits tels qu'ils sont en mémoire, pour
+ * être lus sur place par \ref ReplayArchive : une archive ne se lit que sur
+ * une machine de même boutisme et avec une même \ref GameSnapshot.
+ */
+class ReplayArchiveWriter{
+public:
+    constexpr static unsigned KEYFRAME_INTERVAL {256};
+    /*!< Le nombre par défaut de descentes automatiques entre deux images clés. */
+
+private:
+    std::ofstream out_;
+    /*!< Le fichier de l'archive. */
+
+    std::string path_;
+    /*!< Le chemin du fichier, pour les messages d'erreur. */
+
+    std::vector<ArchiveEntry> entries_;
+    /*!< L'index des parties déjà ajoutées. */
+
+    std::uint64_t offset_;
+    /*!< La taille de l'archive déjà écrite. */
+
+    unsigned interval_;
+    /*!< Le nombre de descentes automatiques entre deux images clés. */
+
+    bool closed_;
+    /*!< L'index a-t-il été écrit. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref ReplayArchiveWriter.
+     *
+     * \param path le chemin de l'archive, remplacée si elle existe
+     * \param interval le nombre de descentes automatiques entre deux images clés
+     * \throw std::invalid_argument si interval est nul ou si le fichier ne peut être créé
+     */
+    explicit ReplayArchiveWriter(const std::string & path, unsigned interval = KEYFRAME_INTERVAL);
+
+    ReplayArchiveWriter(const ReplayArchiveWriter &) = delete;
+    ReplayArchiveWriter & operator=(const ReplayArchiveWriter &) = delete;
+
+    /*!
+     * \brief Destructeur de \ref ReplayArchiveWriter.
+     *
+     * L'archive est fermée si elle ne l'a pas été par \ref close ; une erreur
+     * d'écriture est alors ignorée.
+     */
+    ~ReplayArchiveWriter();
+
+    /*!
+     * \brief Méthode ajoutant un enregistrement à l'archive.
+     *
+     * La partie est rejouée pour calculer ses images clés.
+     *
+     * \param replay l'enregistrement, terminé
+     * \throw std::logic_error si l'enregistrement n'est pas terminé ou si l'archive est fermée
+     * \throw std::invalid_argument si l'archive ne peut être écrite
+     */
+    void add(const Replay & replay);
+
+    /*!
+     * \brief Méthode écrivant l'index et fermant l'archive.
+     *
+     * \throw std::invalid_argument si l'archive ne peut être écrite
+     */
+    void close();
+
+    /*!
+     * \brief Accesseur en lecture du nombre de parties ajoutées.
+     * \return le nombre de parties
+     */
+    inline std::size_t getSize() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'intervalle entre deux images clés.
+     * \return le nombre de descentes automatiques
+     */
+    inline unsigned getInterval() const;
+
+private:
+    /*!
+     * \brief Méthode écrivant des octets à la suite de l'archive.
+     *
+     * \param data les octets
+     * \param size le nombre d'octets
+     * \throw std::invalid_argument si l'écriture échoue
+     */
+    void write(const void * data, std::size_t size);
+
+    /*!
+     * \brief Méthode complétant l'archive par des zéros jusqu'à un multiple de 8 octets.
+     *
+     * \throw std::invalid_argument si l'écriture échoue
+     */
+    void align();
+};
+
+/*!
+ * \brief Classe lisant une archive écrite par \ref ReplayArchiveWriter.
+ *
+ * L'archive est projetée en mémoire par un \ref MappedFile : l'ouvrir ne lit
+ * que son index, et ni l'index ni les actions ne sont copiés. Une partie est
+ * atteinte directement par son numéro, et un instant d'une partie en
+ * restaurant la dernière image clé qui le précède, trouvée par recherche
+ * dichotomique, puis en rejouant au plus un intervalle de descentes.
+ */
+class ReplayArchive{
+    MappedFile file_;
+    /*!< Le fichier de l'archive. */
+
+    const ArchiveEntry * entries_;
+    /*!< L'index des parties, dans le fichier. */
+
+    std::size_t size_;
+    /*!< Le nombre de parties. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref ReplayArchive.
+     *
+     * \param path le chemin de l'archive
+     * \throw std::invalid_argument si le fichier n'est pas une archive valide
+     * sur cette machine
+     */
+    explicit ReplayArchive(const std::string & path);
+
+    /*!
+     * \brief Accesseur en lecture du nombre de parties.
+     * \return le nombre de parties
+     */
+    inline std::size_t getSize() const;
+
+    /*!
+     * \brief Accesseur en lecture de la description d'une partie.
+     *
+     * \param game le numéro de la partie
+     * \return la description, dans le fichier
+     * \throw std::out_of_range si la partie n'existe pas
+     */
+    const ArchiveEntry & getEntry(std::size_t game) const;
+
+    /*!
+     * \brief Accesseur en lecture de la configuration d'une partie.
+     *
+     * \param game le numéro de la partie
+     * \return la configuration
+     * \throw std::out_of_range si la partie n'existe pas
+     * \throw std::invalid_argument si l'enregistrement est corrompu
+     */
+    ReplayHeader getHeader(std::size_t game) const;
+
+    /*!
+     * \brief Méthode copiant et vérifiant entièrement l'enregistrement d'une partie.
+     *
+     * \param game le numéro de la partie
+     * \return l'enregistrement
+     * \throw std::out_of_range si la partie n'existe pas
+     * \throw std::invalid_argument si l'enregistrement est corrompu
+     */
+    Replay getReplay(std::size_t game) const;
+
+    /*!
+     * \brief Méthode amenant une \ref Simulation à un instant d'une partie.
+     *
+     * La simulation est préparée comme par \ref Replay::start, reçoit la
+     * dernière image clé qui précède l'instant demandé, puis rejoue les
+     * descentes restantes. Le \ref ReplayPlayer rendu lit les actions dans
+     * l'archive, qui doit rester ouverte tant qu'il est utilisé.
+     *
+     * \param game le numéro de la partie
+     * \param tick le nombre de descentes automatiques à rejouer, borné à la fin de la partie
+     * \param simulation la partie
+     * \return le lecteur, prêt à rejouer la suite de la partie
+     * \throw std::out_of_range si la partie n'existe pas
+     * \throw std::invalid_argument si l'enregistrement est corrompu
+     */
+    ReplayPlayer seek(std::size_t game, std::uint64_t tick, Simulation & simulation) const;
+};
+
+//méthodes inline
+std::size_t ReplayArchiveWriter::getSize() const{
+    return entries_.size();
+}
+
+unsigned ReplayArchiveWriter::getInterval() const{
+    return interval_;
+}
+
+std::size_t ReplayArchive::getSize() const{
+    return size_;
+}
+
+} // namespace GJ_GW
+
+#endif // REPLAYARCHIVE_H
@@ -0,0 +1,27 @@
+#ifndef ROW_H
+#define ROW_H
+
+#include <cstdint>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Type représentant l'occupation d'une ligne de la grille de jeu.
+ *
+ * Le bit n°x vaut 1 si la case d'abscisse x de la ligne est pleine.
+ */
+typedef std::uint16_t Row;
+
+/*!
+ * \brief Type représentant l'occupation d'une colonne de la grille de jeu.
+ *
+ * Le bit n°y vaut 1 si la case d'ordonnée y de la colonne est pleine.
+ */
+typedef std::uint32_t Column;
+
+} // namespace GJ_GW
+
+#endif // ROW_H
@@ -0,0 +1,725 @@
+#include "simulation.h"
+#include "eventobserver.h"
+#include "movegenerator.h"
+#include "replay.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace GJ_GW;
+
+Simulation::Simulation(): level_ {0}, winScore_{validateWinScore(3000)},
+    winLines_{validateWinLines(50)}, winTime_{validateWinTime(300000)},
+    gameState_{GameState::NONE}, board_{Board(validateWidth(10), validateHeight(20))},
+    clearedRows_{0}, newBric_{0}, winByScore_{1}, winByLines_{1}, winByTime_{1}, recording_{nullptr}, eventKinds_{0}{
+}
+
+unsigned Simulation::getLevel() const{
+    unsigned lvl = level_ + (player_.nbLines_/10);
+    return (lvl > 6)? 6 : lvl;
+}
+
+unsigned Simulation::getInterval() const{
+    unsigned steps {level_ + player_.nbLines_/10};
+    if(steps * INTERVAL_STEP >= MAXIMUM_INTERVAL - MINIMUM_INTERVAL){
+        return MINIMUM_INTERVAL;
+    }
+    return MAXIMUM_INTERVAL - steps * INTERVAL_STEP;
+}
+
+unsigned Simulation::getWinScore() const{
+    return winScore_;
+}
+
+unsigned Simulation::getWinLines() const{
+    return winLines_;
+}
+
+unsigned Simulation::getWinTime() const{
+    return winTime_;
+}
+
+Player Simulation::getPlayer() const{
+    return player_;
+}
+
+Bric Simulation::getNextBric() const{
+    return bag_.getNextBric();
+}
+
+const Bric & Simulation::getPreview(unsigned index) const{
+    return bag_.getPreview(index);
+}
+
+std::uint64_t Simulation::getHash() const{
+    constexpr std::uint64_t PIECE {1ull << 56};
+    constexpr std::uint64_t QUEUE {2ull << 56};
+    const unsigned mask {BricsBag::QUEUE_SIZE - 1};
+    std::uint64_t hash {board_.getHash()};
+    if(bag_.count_ != 0){
+        hash ^= Zobrist::key(PIECE | std::uint64_t(bag_.queue_[bag_.head_]) << 24
+                             | currentBric_.rotation_ << 16
+                             | (currentBric_.middle_.getX() & 0xFF) << 8 | (currentBric_.middle_.getY() & 0xFF));
+    }
+    for(unsigned u {0}; u < bag_.depth_ && u + 1 < bag_.count_; ++u){
+        hash ^= Zobrist::key(QUEUE | std::uint64_t(u) << 32 | bag_.queue_[(bag_.head_ + 1 + u) & mask]);
+    }
+    return hash;
+}
+
+std::uint16_t Simulation::getChecksum() const{
+    constexpr std::uint64_t PIECE {1ull << 56};
+    constexpr std::uint64_t PLAYER {3ull << 56};
+    std::uint64_t hash {board_.getHash() ^ Zobrist::key(PLAYER | std::uint64_t(player_.score_) << 24 | player_.nbLines_)};
+    if(bag_.count_ != 0){
+        hash ^= Zobrist::key(PIECE | std::uint64_t(bag_.queue_[bag_.head_]) << 24
+                             | currentBric_.rotation_ << 16
+                             | (currentBric_.middle_.getX() & 0xFF) << 8 | (currentBric_.middle_.getY() & 0xFF));
+    }
+    return static_cast<std::uint16_t>(hash ^ hash >> 16 ^ hash >> 32 ^ hash >> 48);
+}
+
+std::vector<Placement> Simulation::getPlacements() const{
+    std::vector<Placement> placements;
+    if(gameState_ == GameState::ON){
+        MoveGenerator::generate(board_, currentBric_, true, placements);
+    }
+    return placements;
+}
+
+const Board & Simulation::getBoard() const{
+    return board_;
+}
+
+GameState Simulation::getGameState() const{
+    return gameState_;
+}
+
+bool Simulation::hasNewBric() const{
+    return newBric_;
+}
+
+bool Simulation::hasWinByScore() const{
+    return winByScore_;
+}
+
+bool Simulation::hasWinByLines() const{
+    return winByLines_;
+}
+
+bool Simulation::hasWinByTime() const{
+    return winByTime_;
+}
+
+void Simulation::setBag(std::vector<Bric> newBag, bool keepBag){
+    if(keepBag){
+        bag_.add(newBag);
+    } else{
+        replaceBag(BricsBag(newBag));
+    }
+    if(gameState_ == GameState::ON || gameState_ == GameState::NEW_BRIC){
+        internBag();
+    }
+}
+
+void Simulation::resetBag(){
+    replaceBag(BricsBag());
+    if(gameState_ == GameState::ON || gameState_ == GameState::NEW_BRIC){
+        internBag();
+    }
+}
+
+void Simulation::setSeed(std::uint64_t seed){
+    bag_.setSeed(seed);
+}
+
+std::uint64_t Simulation::getSeed() const{
+    return bag_.seed_;
+}
+
+void Simulation::setBagPolicy(BagPolicy policy){
+    bag_.setPolicy(policy);
+}
+
+BagPolicy Simulation::getBagPolicy() const{
+    return bag_.policy_;
+}
+
+void Simulation::setPreviewDepth(unsigned depth){
+    bag_.setPreviewDepth(depth);
+}
+
+unsigned Simulation::getPreviewDepth() const{
+    return bag_.depth_;
+}
+
+void Simulation::replaceBag(BricsBag bag){
+    bag.setSeed(bag_.seed_);
+    bag.setPolicy(bag_.policy_);
+    bag.depth_ = bag_.depth_;
+    bag.shuffle(true);
+    bag_ = bag;
+}
+
+void Simulation::internBag(){
+    for(Bric & bric : bag_.brics_){
+        bric.paletteIndex_ = board_.palette_.intern(bric.color_);
+    }
+}
+
+void Simulation::initGame(std::string name, unsigned width, unsigned height,
+                          unsigned winScore, unsigned winLines, unsigned winTime,
+                          unsigned level, bool winByScore, bool winByLines,
+                          bool winByTime){
+    player_.setPlayer(name);
+    board_ = Board(validateWidth(width), validateHeight(height));
+    winScore_ = validateWinScore(winScore);
+    winLines_ = validateWinLines(winLines);
+    winTime_ = validateWinTime(winTime);
+    winByScore_ = winByScore;
+    winByLines_ = winByLines;
+    winByTime_ = winByTime;
+    level_ = level;
+    gameState_ = GameState::INITIALIZED;
+    publishScore();
+    publishState();
+}
+
+void Simulation::startGame(){
+    if(gameState_ == GameState::INITIALIZED){
+        generateBric(true);
+    }
+}
+
+void Simulation::step(Input input){
+    if(gameState_ != GameState::ON){
+        return;
+    }
+    if(recording_){
+        recording_->record(input);
+    }
+    switch(input){
+    case Input::NONE:
+        fall();
+        break;
+    case Input::LEFT:
+        checkMove(Direction::LEFT);
+        break;
+    case Input::RIGHT:
+        checkMove(Direction::RIGHT);
+        break;
+    case Input::DOWN:
+        checkMove(Direction::DOWN);
+        break;
+    case Input::ROTATE:
+        checkRotate();
+        break;
+    case Input::DROP:
+        drop();
+        break;
+    }
+    if(recording_ && input == Input::NONE){
+        recording_->check(getChecksum());
+    }
+}
+
+void Simulation::timeOut(){
+    if(gameState_ != GameState::ON){
+        return;
+    }
+    if(recording_){
+        recording_->recordTimeOut();
+    }
+    setGameState(GameState::TIME);
+}
+
+void Simulation::setRecording(Replay * replay){
+    recording_ = replay;
+}
+
+void Simulation::finishRecording(){
+    if(recording_){
+        recording_->finish(ReplayResult{board_.hash_, player_.score_, player_.nbLines_, gameState_});
+    }
+}
+
+void Simulation::addEventObserver(EventObserver * observer, unsigned kinds){
+    auto it = std::find_if(eventObservers_.begin(), eventObservers_.end(),
+                           [observer](const std::pair<EventObserver *, unsigned> & o){ return o.first == observer; });
+    if(it == eventObservers_.end()){
+        eventObservers_.emplace_back(observer, kinds & GameEvent::ALL);
+    } else{
+        it->second = kinds & GameEvent::ALL;
+    }
+    eventKinds_ = 0;
+    for(const auto & o : eventObservers_){
+        eventKinds_ |= o.second;
+    }
+}
+
+void Simulation::removeEventObserver(EventObserver * observer){
+    eventObservers_.erase(std::remove_if(eventObservers_.begin(), eventObservers_.end(),
+                                         [observer](const std::pair<EventObserver *, unsigned> & o){
+                                             return o.first == observer;
+                                         }), eventObservers_.end());
+    eventKinds_ = 0;
+    for(const auto & o : eventObservers_){
+        eventKinds_ |= o.second;
+    }
+}
+
+GameSnapshot Simulation::capture() const{
+    GameSnapshot snapshot;
+    snapshot.width = board_.width_;
+    snapshot.height = board_.height_;
+    snapshot.colors = board_.palette_.getSize();
+    for(unsigned u {0}; u < snapshot.colors; ++u){
+        snapshot.palette[u] = board_.palette_.getColor(u).getCode();
+    }
+    std::copy_n(board_.rows_.begin(), snapshot.rows.size(), snapshot.rows.begin());
+    std::copy_n(board_.columns_.begin(), snapshot.columns.size(), snapshot.columns.begin());
+    std::copy_n(board_.cells_.begin(), snapshot.cells.size(), snapshot.cells.begin());
+    snapshot.hash = board_.hash_;
+
+    snapshot.brics = bag_.brics_.size();
+    snapshot.random = bag_.random_.state_;
+    snapshot.count = bag_.count_;
+    for(unsigned u {0}; u < bag_.count_; ++u){
+        snapshot.queue[u] = bag_.queue_[(bag_.head_ + u) & (BricsBag::QUEUE_SIZE - 1)];
+    }
+    snapshot.history = bag_.history_;
+    snapshot.historySize = bag_.historySize_;
+    snapshot.remaining = bag_.remaining_;
+    snapshot.remainingSize = bag_.remainingSize_;
+
+    snapshot.rotation = currentBric_.rotation_;
+    snapshot.x = currentBric_.middle_.getX();
+    snapshot.y = currentBric_.middle_.getY();
+    snapshot.score = player_.score_;
+    snapshot.lines = player_.nbLines_;
+    snapshot.level = level_;
+    snapshot.gameState = gameState_;
+    snapshot.clearedRows = clearedRows_;
+    snapshot.elapsed = 0;
+    return snapshot;
+}
+
+void Simulation::restore(const GameSnapshot & snapshot){
+    validateSnapshot(snapshot);
+    // les couleurs étant distinctes, les ajouter dans l'ordre redonne les mêmes indices
+    board_.palette_ = Palette();
+    for(unsigned u {1}; u < snapshot.colors; ++u){
+        std::uint32_t code {snapshot.palette[u]};
+        board_.palette_.intern(Color(code >> 16, (code >> 8) & 0xFF, code & 0xFF));
+    }
+    if(snapshot.gameState > GameState::INITIALIZED){
+        internBag();
+    }
+    std::copy(snapshot.rows.begin(), snapshot.rows.end(), board_.rows_.begin());
+    std::copy(snapshot.columns.begin(), snapshot.columns.end(), board_.columns_.begin());
+    std::copy(snapshot.cells.begin(), snapshot.cells.end(), board_.cells_.begin());
+    board_.hash_ = snapshot.hash;
+    for(unsigned y {0}; y < board_.height_; ++y){
+        board_.markDirty(y, board_.fullRow_);
+    }
+
+    bag_.random_.state_ = snapshot.random;
+    bag_.head_ = 0;
+    bag_.count_ = snapshot.count;
+    std::copy_n(snapshot.queue.begin(), snapshot.count, bag_.queue_.begin());
+    bag_.history_ = snapshot.history;
+    bag_.historySize_ = snapshot.historySize;
+    bag_.remaining_ = snapshot.remaining;
+    bag_.remainingSize_ = snapshot.remainingSize;
+    if(bag_.count_ != 0){
+        while(bag_.count_ < bag_.depth_ + 1){
+            bag_.push();
+        }
+        currentBric_ = bag_.getCurrentBric();
+        currentBric_.rotation_ = snapshot.rotation;
+        currentBric_.middle_ = Position(snapshot.x, snapshot.y);
+        newBric_ = 1;
+    }
+
+    player_.score_ = snapshot.score;
+    player_.nbLines_ = snapshot.lines;
+    level_ = snapshot.level;
+    gameState_ = snapshot.gameState;
+    clearedRows_ = snapshot.clearedRows;
+    if(bag_.count_ != 0){
+        publishBric(GameEventKind::PIECE_SPAWNED, getPlacement());
+    }
+    publishScore();
+    publishState();
+    changed();
+}
+
+void Simulation::validateSnapshot(const GameSnapshot & snapshot) const{
+    if(snapshot.width != board_.width_ || snapshot.height != board_.height_
+            || snapshot.colors == 0 || snapshot.colors > Palette::MAXIMUM_COLORS
+            || snapshot.brics != bag_.brics_.size()){
+        throw std::invalid_argument("l'instantané n'a pas été pris dans cette partie");
+    }
+    for(unsigned y {0}; y < snapshot.rows.size(); ++y){
+        if(snapshot.rows[y] & ~(y < board_.height_ ? board_.fullRow_ : Row(0))){
+            throw std::invalid_argument("l'instantané contient une case hors de la grille");
+        }
+    }
+    for(unsigned x {0}; x < snapshot.columns.size(); ++x){
+        Column column {0};
+        for(unsigned y {0}; x < board_.width_ && y < board_.height_; ++y){
+            std::uint8_t cell {snapshot.cells[y * board_.width_ + x]};
+            bool filled {(snapshot.rows[y] >> x & 1) != 0};
+            if(cell >= snapshot.colors || filled != (cell != 0)){
+                throw std::invalid_argument("l'instantané contient une case incohérente");
+            }
+            column |= Column(filled) << y;
+        }
+        if(snapshot.columns[x] != column){
+            throw std::invalid_argument("l'instantané contient une colonne incohérente");
+        }
+    }
+    auto below = [&snapshot](unsigned index){ return index < snapshot.brics; };
+    if(snapshot.count > snapshot.queue.size() || snapshot.count > BricsBag::QUEUE_SIZE
+            || snapshot.historySize > snapshot.history.size()
+            || snapshot.remainingSize > snapshot.remaining.size()
+            || !std::all_of(snapshot.queue.begin(), snapshot.queue.begin() + snapshot.count, below)
+            || !std::all_of(snapshot.history.begin(), snapshot.history.begin() + snapshot.historySize, below)
+            || !std::all_of(snapshot.remaining.begin(), snapshot.remaining.begin() + snapshot.remainingSize, below)){
+        throw std::invalid_argument("l'instantané contient un sac incohérent");
+    }
+    if(snapshot.gameState > GameState::OTHER_LINE || (snapshot.clearedRows >> board_.height_) != 0){
+        throw std::invalid_argument("l'instantané contient un état de partie inconnu");
+    }
+    if(snapshot.gameState > GameState::INITIALIZED){
+        for(const Bric & bric : bag_.brics_){
+            if(std::find(snapshot.palette.begin(), snapshot.palette.begin() + snapshot.colors,
+                         bric.color_.getCode()) == snapshot.palette.begin() + snapshot.colors){
+                throw std::invalid_argument("l'instantané ne contient pas les couleurs du sac");
+            }
+        }
+    }
+    if(snapshot.rotation >= Bric::ORIENTATIONS){
+        throw std::invalid_argument("l'instantané contient une brique hors de la grille");
+    }
+    // avant le début de la partie, la brique courante n'a pas encore été placée dans la grille
+    if(snapshot.count != 0 && snapshot.gameState > GameState::INITIALIZED){
+        const Bric::Orientation & o {bag_.brics_[snapshot.queue[0]].orientations_[snapshot.rotation]};
+        // seul le cadre doit tenir dans la grille : le milieu peut en sortir, en négatif
+        long long left {static_cast<long long>(static_cast<std::int32_t>(snapshot.x)) + o.left};
+        long long top {static_cast<long long>(static_cast<std::int32_t>(snapshot.y)) + o.top};
+        if(left < 0 || top < 0 || left + o.width > board_.width_ || top + o.height > board_.height_){
+            throw std::invalid_argument("l'instantané contient une brique hors de la grille");
+        }
+    }
+}
+
+unsigned Simulation::validateWidth(unsigned width){
+    if(width < MINIMUM_WIDTH || width > MAXIMUM_WIDTH){
+        throw std::invalid_argument(message("largeur", width, MINIMUM_WIDTH, MAXIMUM_WIDTH));
+    }
+    return width;
+}
+
+unsigned Simulation::validateHeight(unsigned height){
+    if(height < MINIMUM_HEIGHT || height > MAXIMUM_HEIGHT){
+        throw std::invalid_argument(message("hauteur", height, MINIMUM_HEIGHT, MAXIMUM_HEIGHT));
+    }
+    return height;
+}
+
+unsigned Simulation::validateWinScore(unsigned winScore){
+    if(winScore < MINIMUM_WIN_SCORE || winScore > MAXIMUM_WIN_SCORE){
+        throw std::invalid_argument(message("score de victoire", winScore, MINIMUM_WIN_SCORE, MAXIMUM_WIN_SCORE));
+    }
+    return winScore;
+}
+
+unsigned Simulation::validateWinLines(unsigned winLines){
+    if(winLines < MINIMUM_WIN_LINES || winLines > MAXIMUM_WIN_LINES){
+        throw std::invalid_argument(message("nombre de lignes de victoire", winLines, MINIMUM_WIN_LINES, MAXIMUM_WIN_LINES));
+    }
+    return winLines;
+}
+
+unsigned Simulation::validateWinTime(unsigned winTime){
+    if(winTime < MINIMUM_WIN_TIME || winTime > MAXIMUM_WIN_TIME){
+        throw std::invalid_argument(message("temps de victoire", winTime, MINIMUM_WIN_TIME, MAXIMUM_WIN_TIME));
+    }
+    return winTime;
+}
+
+std::string Simulation::message(const std::string &label, unsigned value, unsigned min, unsigned max){
+    return label +" non valide : "+ std::to_string(value) +" n'est pas compris entre "+ std::to_string(min) +" et "+ std::to_string(max);
+}
+
+void Simulation::generateBric(bool first){
+    if(first){
+        internBag();
+    }
+    if(first && recording_){
+        recording_->begin(ReplayHeader{player_.getName(), board_.width_, board_.height_, winScore_, winLines_,
+                                       winTime_, level_, winByScore_, winByLines_, winByTime_,
+                                       bag_.seed_, bag_.policy_, bag_.brics_});
+    }
+    bag_.shuffle(first);
+    currentBric_ = MoveGenerator::spawn(bag_.getCurrentBric(), board_.width_);
+    bool ok {board_.checkBric(currentBric_, currentBric_.rotation_,
+                              currentBric_.middle_.getX(), currentBric_.middle_.getY(), false)};
+
+    if(ok){
+        board_.addBric(currentBric_);
+        newBric_ = 1;
+        publishBric(GameEventKind::PIECE_SPAWNED, getPlacement());
+        setGameState(GameState::NEW_BRIC);
+    } else{
+        setGameState(GameState::LOOSE);
+    }
+}
+
+void Simulation::drop(){
+    unsigned count {board_.dropDistance(currentBric_)};
+    if(count > 0){
+        const Placement from {getPlacement()};
+        board_.removeBric(currentBric_);
+        for(unsigned u {0}; u < count; ++u){
+            currentBric_.move(Direction::DOWN);
+        }
+        board_.addBric(currentBric_);
+        publishBric(GameEventKind::PIECE_MOVED, from);
+    }
+    checkLines(count + 1);
+    changed();
+}
+
+bool Simulation::checkMove(Direction dir){
+    int x = currentBric_.middle_.getX();
+    int y = currentBric_.middle_.getY();
+    switch(dir){
+    case Direction::LEFT:
+        --x;
+        break;
+    case Direction::RIGHT:
+        ++x;
+        break;
+    case Direction::UP:
+        --y;
+        break;
+    case Direction::DOWN:
+        ++y;
+        break;
+    }
+    bool ok {board_.checkBric(currentBric_, currentBric_.rotation_, x, y, true)};
+    if(ok)
+        moveBric(dir);
+    return ok;
+}
+
+void Simulation::checkRotate(){
+    if(board_.checkBric(currentBric_, (currentBric_.rotation_ + 1) % Bric::ORIENTATIONS,
+                        currentBric_.middle_.getX(), currentBric_.middle_.getY(), true)){
+        rotateBric();
+    }
+}
+
+void Simulation::rotateBric(){
+    const Placement from {getPlacement()};
+    board_.removeBric(currentBric_);
+    currentBric_.rotate();
+    board_.addBric(currentBric_);
+    publishBric(GameEventKind::PIECE_MOVED, from);
+    changed();
+}
+
+void Simulation::moveBric(Direction dir){
+    const Placement from {getPlacement()};
+    board_.removeBric(currentBric_);
+    currentBric_.move(dir);
+    board_.addBric(currentBric_);
+    publishBric(GameEventKind::PIECE_MOVED, from);
+    if(dir != Direction::DOWN)
+        changed();
+}
+
+unsigned Simulation::checkLines(unsigned dropsCount){
+    clearedRows_ = board_.clearLines();
+    unsigned linesFilled = __builtin_popcount(clearedRows_);
+    if(clearedRows_ != 0 && isPublished(GameEventKind::LINES_CLEARED)){
+        GameEvent event {};
+        event.kind = GameEventKind::LINES_CLEARED;
+        event.rows = clearedRows_;
+        publish(event);
+    }
+    const unsigned score {player_.score_};
+    const unsigned lines {player_.nbLines_};
+    player_.setNbLines(linesFilled);
+    player_.setScore(dropsCount, linesFilled);
+    if(player_.score_ != score || player_.nbLines_ != lines){
+        publishScore();
+    }
+    if(player_.score_ >= winScore_){
+        if(winByScore_)
+            setGameState(GameState::SCORE);
+    } else if(player_.nbLines_ >= winLines_){
+        if(winByLines_)
+            setGameState(GameState::LINE);
+    }
+    return linesFilled;
+}
+
+void Simulation::setGameState(GameState gameState){
+    const GameState previous {gameState_};
+    gameState_ = gameState;
+    if(gameState_ > GameState::ON){
+        finishRecording();
+    }
+    if(gameState_ != previous && gameState_ != GameState::NEW_BRIC && previous != GameState::NEW_BRIC){
+        publishState();
+    }
+    if(gameState_ <= GameState::ON){
+        changed();
+    }
+    if(gameState_ == GameState::NEW_BRIC){
+        setGameState(GameState::ON);
+        if(previous != GameState::ON && gameState_ == GameState::ON){
+            publishState();
+        }
+    }
+}
+
+void Simulation::changed(){
+}
+
+void Simulation::clearChanges(){
+    board_.clearDirty();
+    newBric_ = 0;
+}
+
+void Simulation::fall(){
+    if(! checkMove(Direction::DOWN)){
+        publishBric(GameEventKind::PIECE_LOCKED, getPlacement());
+        checkLines(0);
+        if(gameState_ == GameState::ON){
+            generateBric();
+        }
+    }
+    changed();
+}
+
+void Simulation::boardSwapCase(Position &pos, Color color){
+    board_.swapCase(pos, color);
+}
+
+Bric Simulation::getCurrentBric() const{
+    return currentBric_;
+}
+
+Column Simulation::getClearedRows() const{
+    return clearedRows_;
+}
+
+void Simulation::publish(const GameEvent & event){
+    const unsigned kind {GameEvent::mask(event.kind)};
+    if((eventKinds_ & kind) == 0){
+        return;
+    }
+    for(std::size_t i {0}; i < eventObservers_.size(); ++i){
+        if(eventObservers_[i].second & kind){
+            eventObservers_[i].first->onEvent(event);
+        }
+    }
+}
+
+bool Simulation::isPublished(GameEventKind kind) const{
+    return eventKinds_ & GameEvent::mask(kind);
+}
+
+Placement Simulation::getPlacement() const{
+    return Placement{currentBric_.rotation_, static_cast<int>(currentBric_.middle_.getX()),
+                     static_cast<int>(currentBric_.middle_.getY())};
+}
+
+void Simulation::publishBric(GameEventKind kind, const Placement & from){
+    if(!isPublished(kind)){
+        return;
+    }
+    GameEvent event {};
+    event.kind = kind;
+    event.bric = bag_.queue_[bag_.head_];
+    event.from = from;
+    event.to = getPlacement();
+    publish(event);
+}
+
+void Simulation::publishScore(){
+    if(!isPublished(GameEventKind::SCORE_CHANGED)){
+        return;
+    }
+    GameEvent event {};
+    event.kind = GameEventKind::SCORE_CHANGED;
+    event.score = player_.score_;
+    event.lines = player_.nbLines_;
+    publish(event);
+}
+
+void Simulation::publishState(){
+    if(!isPublished(GameEventKind::STATE_CHANGED)){
+        return;
+    }
+    GameEvent event {};
+    event.kind = GameEventKind::STATE_CHANGED;
+    event.state = gameState_;
+    publish(event);
+}
+
+void Simulation::addLine(const std::vector<int> & line){
+    if(gameState_ != GameState::ON){
+        return;
+    }
+    // chaque ligne reçue pousse les précédentes vers le haut : la 1ère finit la plus haute
+    std::vector<Row> rows;
+    Row row {0};
+    for(int x : line){
+        if(x == -1){
+            rows.push_back(row);
+            row = 0;
+        } else if(x < 0 || static_cast<unsigned>(x) >= board_.width_){
+            throw std::out_of_range("la case est hors de la grille");
+        } else{
+            row |= Row(1) << x;
+        }
+    }
+    if(recording_){
+        recording_->recordLines(line);
+    }
+    if(rows.empty()){
+        return;
+    }
+    const Placement from {getPlacement()};
+    board_.removeBric(currentBric_);
+    bool kept {board_.addRows(rows, Color(128, 128, 128))};
+    // la brique courante reste en place, ou remonte avec la grille si elle est recouverte
+    unsigned raise {0};
+    while(kept && !board_.checkBric(currentBric_, currentBric_.rotation_, currentBric_.middle_.getX(),
+                                    static_cast<int>(currentBric_.middle_.getY() - raise), false)){
+        kept = ++raise <= rows.size();
+    }
+    if(!kept){
+        setGameState(GameState::LOOSE);
+        return;
+    }
+    for(unsigned u {0}; u < raise; ++u){
+        currentBric_.move(Direction::UP);
+    }
+    board_.addBric(currentBric_);
+    if(raise > 0){
+        publishBric(GameEventKind::PIECE_MOVED, from);
+    }
+    if(isPublished(GameEventKind::GARBAGE_RECEIVED)){
+        GameEvent event {};
+        event.kind = GameEventKind::GARBAGE_RECEIVED;
+        event.count = rows.size();
+        publish(event);
+    }
+    changed();
+}
@@ -0,0 +1,762 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "player.h"
+#include "board.h"
+#include "bricsBag.h"
+#include "gamestate.h"
+#include "direction.h"
+#include "input.h"
+#include "placement.h"
+#include "gamesnapshot.h"
+#include "gameevent.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+class Replay;
+class EventObserver;
+
+static_assert(Palette::MAXIMUM_COLORS >= BricsBag::MAXIMUM_BRICS + 2,
+              "la palette doit contenir les couleurs du plus grand sac, le blanc et le gris");
+
+/*!
+ * \brief Classe implémentant les règles d'une partie de Tetris, sans dépendance à Qt.
+ *
+ * Elle contient toutes les données d'une partie (grille, sac, brique courante,
+ * joueur, niveau) et n'avance que par des appels explicites à \ref step :
+ * elle ne connaît ni la boucle d'événements, ni le temps réel. Une partie
+ * peut ainsi être jouée par un robot, un serveur ou un outil en ligne de commande
+ * aussi vite que le processeur le permet.
+ *
+ * \ref Tetris l'enveloppe et y ajoute le timer, le chronomètre et les \ref Observer.
+ * Les méthodes virtuelles protégées lui servent de points d'extension.
+ *
+ * Chaque modification est aussi publiée sous forme de \ref GameEvent aux
+ * \ref EventObserver abonnés à sa sorte. Un événement n'est construit que si
+ * un observateur y est abonné : une partie sans abonné n'en paie pas le coût.
+ */
+class Simulation{
+public:
+    constexpr static unsigned MINIMUM_WIDTH {6};
+    /*!< Valeur minimale acceptée pour la largeur. */
+
+    constexpr static unsigned MAXIMUM_WIDTH {12};
+    /*!< Valeur maximale acceptée pour la largeur. */
+
+    constexpr static unsigned MINIMUM_HEIGHT {12};
+    /*!< Valeur minimale acceptée pour la hauteur. */
+
+    constexpr static unsigned MAXIMUM_HEIGHT {24};
+    /*!< Valeur maximale acceptée pour la hauteur. */
+
+    constexpr static unsigned MINIMUM_WIN_SCORE {1000};
+    /*!< Valeur minimale acceptée pour le score de victoire. */
+
+    constexpr static unsigned MAXIMUM_WIN_SCORE {25000};
+    /*!< Valeur maximale acceptée pour le score de victoire. */
+
+    constexpr static unsigned MINIMUM_WIN_LINES {20};
+    /*!< Valeur minimale acceptée pour le nombe de lignes de victoire. */
+
+    constexpr static unsigned MAXIMUM_WIN_LINES {100};
+    /*!< Valeur maximale acceptée pour le nombe de lignes de victoire. */
+
+    constexpr static unsigned MINIMUM_WIN_TIME {60000};
+    /*!< Valeur minimale acceptée pour le temps de victoire. */
+
+    constexpr static unsigned MAXIMUM_WIN_TIME {3599000};
+    /*!< Valeur maximale acceptée pour le temps de victoire. */
+
+    constexpr static unsigned MINIMUM_INTERVAL {150};
+    /*!< Valeur minimale de l'intervalle entre deux descentes automatiques, en milliseconde. */
+
+    constexpr static unsigned MAXIMUM_INTERVAL {1200};
+    /*!< Valeur maximale de l'intervalle entre deux descentes automatiques, en milliseconde. */
+
+    constexpr static unsigned INTERVAL_STEP {200};
+    /*!< La réduction de l'intervalle par niveau de difficulté, en milliseconde. */
+
+private:
+    unsigned level_;
+    /*!< Niveau de difficulté au démarrage de la partie. */
+
+    unsigned winScore_;
+    /*!< Le score de victoire.
+     *
+     * Il représente le score à atteindre pour gagner une partie.
+     *
+     * Sa valeur peut aller de \ref MINIMUM_WIN_SCORE à \ref MAXIMUM_WIN_SCORE.
+     */
+
+    unsigned winLines_;
+    /*!< Le nombre de lignes de victoire.
+     *
+     * Il représente le nombre de lignes à remplir pour gagner une partie.
+     *
+     * Sa valeur peut aller de \ref MINIMUM_WIN_LINES à \ref MAXIMUM_WIN_LINES.
+     */
+
+    unsigned winTime_;
+    /*!< Le temps de victoire.
+     *
+     * Il représente le temps de jeu à atteindre pour gagner une partie.
+     *
+     * Sa valeur peut aller de \ref MINIMUM_WIN_TIME à \ref MAXIMUM_WIN_TIME.
+     */
+
+    GameState gameState_;
+    /*!< L'état de la partie. */
+
+    Player player_;
+    /*!< Le joueur. */
+
+    Board board_;
+    /*!< La grille de jeu. */
+
+    BricsBag bag_;
+    /*!< Le sac de briques. */
+
+    Bric currentBric_;
+    /*!< La brique courante.
+     *
+     * Celle que contrôle le joueur.
+     */
+
+    Column clearedRows_;
+    /*!< Les lignes vidées lors de la dernière pose de brique. */
+
+    bool newBric_;
+    /*!< Une \ref Bric a-t-elle été mise en jeu depuis le dernier appel à \ref clearChanges. */
+
+    bool winByScore_;
+    /*!< La victoire par score est-elle activée. */
+
+    bool winByLines_;
+    /*!< La victoire par lignes est-elle activée. */
+
+    bool winByTime_;
+    /*!< La victoire par temps est-elle activée. */
+
+    Replay * recording_;
+    /*!< L'enregistrement des parties, nullptr si elles ne sont pas enregistrées. */
+
+    std::vector<std::pair<EventObserver *, unsigned>> eventObservers_;
+    /*!< Les \ref EventObserver et les masques des sortes d'événements auxquelles ils sont abonnés. */
+
+    unsigned eventKinds_;
+    /*!< L'union des masques de \ref eventObservers_ : les sortes d'événements à publier. */
+
+public:
+    /*!
+     * \brief Constructeur sans argument de \ref Simulation.
+     *
+     * Il initialise la partie avec les paramètres par défaut,
+     * crée un \ref Player, un \ref Board et un \ref BricsBag par défaut.
+     */
+    Simulation();
+
+    /*!
+     * \brief Destructeur virtuel de \ref Simulation.
+     */
+    virtual ~Simulation() = default;
+
+    /*!
+     * \brief Méthode permettant d'initialiser des \ref Bric personnalisées.
+     * \param newBag les briques que le joueur souhaite créer
+     * \param keepBag indique si le joueur souhaite ajouter ses briques au
+     * sac déjà existant ou s'il souhaite créer un nouveau sac de briques.
+     */
+    void setBag(std::vector<Bric> newBag, bool keepBag = true);
+
+    /*!
+     * \brief Méthode réinitialisant le \ref BricsBag à sa valeur par défaut.
+     */
+    void resetBag();
+
+    /*!
+     * \brief Accesseur en écriture de la graine du \ref BricsBag.
+     *
+     * Elle s'applique au prochain lancement de partie : deux parties lancées
+     * avec la même graine, la même politique et le même sac reçoivent
+     * les mêmes briques.
+     *
+     * \param seed la graine
+     */
+    void setSeed(std::uint64_t seed);
+
+    /*!
+     * \brief Accesseur en lecture de la graine du \ref BricsBag.
+     * \return la graine
+     */
+    std::uint64_t getSeed() const;
+
+    /*!
+     * \brief Accesseur en écriture de la manière dont le \ref BricsBag tire les briques.
+     * \param policy la politique de tirage
+     */
+    void setBagPolicy(BagPolicy policy);
+
+    /*!
+     * \brief Accesseur en lecture de la manière dont le \ref BricsBag tire les briques.
+     * \return la politique de tirage
+     */
+    BagPolicy getBagPolicy() const;
+
+    /*!
+     * \brief Accesseur en écriture du nombre de \ref Bric à venir visibles.
+     *
+     * Ce nombre ne modifie pas la suite des briques distribuées.
+     *
+     * \param depth le nombre de briques visibles après la brique courante,
+     * entre 1 et \ref BricsBag::MAXIMUM_PREVIEW
+     * \throw std::invalid_argument si le nombre est invalide
+     */
+    void setPreviewDepth(unsigned depth);
+
+    /*!
+     * \brief Accesseur en lecture du nombre de \ref Bric à venir visibles.
+     * \return le nombre de briques visibles après la brique courante
+     */
+    unsigned getPreviewDepth() const;
+
+    /*!
+     * \brief Méthode ré-initialisant la partie avec les paramètres donnés.
+     *
+     * La construction du \ref Board choisit les noyaux \ref BoardKernel
+     * spécialisés pour la largeur et la hauteur demandées.
+     *
+     * \param name le nom du joueur
+     * \param width la largeur du \ref Board
+     * \param height la hauteur du \ref Board
+     * \param winScore le score de victoire
+     * \param winLines le nombre de lignes de victoire
+     * \param winTime le temps de victoire
+     * \param level le niveau de difficulté de départ
+     * \param winByScore si la victoire au score est activée ou non
+     * \param winByLines si la victoire aux lignes est activée ou non
+     * \param winByTime si la victoire au temps est activée ou non
+     * \throw std::invalid_argument si un paramètre n'est pas dans ses bornes
+     */
+    virtual void initGame(std::string name, unsigned width, unsigned height, unsigned winScore,
+                          unsigned winLines, unsigned winTime, unsigned level,
+                          bool winByScore, bool winByLines, bool winByTime);
+
+    /*!
+     * \brief Méthode lançant une partie initialisée en générant la \ref Bric courante.
+     */
+    virtual void startGame();
+
+    /*!
+     * \brief Méthode faisant avancer la partie d'un pas.
+     *
+     * Le pas applique l'action donnée, ou la descente automatique de la
+     * \ref Bric courante si aucune action n'est donnée. Il est ignoré si
+     * la partie n'est pas en cours.
+     *
+     * Le résultat ne dépend que de l'état de la partie et de l'action :
+     * rejouer les mêmes actions sur la même partie donne la même grille.
+     *
+     * \param input l'action à appliquer
+     */
+    virtual void step(Input input);
+
+    /*!
+     * \brief Méthode terminant la partie en cours parce que le temps est écoulé.
+     *
+     * Le temps n'étant pas une action passée à \ref step, sa fin est enregistrée
+     * à part : une partie rejouée se termine à la même descente automatique.
+     * Elle est ignorée si la partie n'est pas en cours.
+     */
+    void timeOut();
+
+    /*!
+     * \brief Accesseur en écriture de l'enregistrement des parties.
+     *
+     * Chaque partie lancée ensuite est enregistrée dans le \ref Replay donné,
+     * qui reçoit la configuration de la partie, les actions passées à \ref step
+     * et \ref addLine, la fin du temps par \ref timeOut, puis le résultat à la fin de la partie. Les actions
+     * appliquées directement, par \ref checkMove par exemple, ne sont pas enregistrées.
+     *
+     * \param replay l'enregistrement, qui doit rester en vie tant qu'il est utilisé,
+     * nullptr pour ne plus enregistrer
+     */
+    void setRecording(Replay * replay);
+
+    /*!
+     * \brief Méthode terminant l'enregistrement de la partie en cours avec son état actuel.
+     *
+     * Elle est appelée automatiquement à la fin de la partie.
+     */
+    void finishRecording();
+
+    /*!
+     * \brief Méthode abonnant un \ref EventObserver à des sortes d'événements.
+     *
+     * Si l'observateur est déjà abonné, son abonnement est remplacé.
+     *
+     * \param observer l'observateur, qui doit rester en vie tant qu'il est abonné
+     * \param kinds les masques des sortes d'événements, combinés par
+     * \ref GameEvent::mask, toutes par défaut
+     */
+    void addEventObserver(EventObserver * observer, unsigned kinds = GameEvent::ALL);
+
+    /*!
+     * \brief Méthode désabonnant un \ref EventObserver de tous les événements.
+     * \param observer l'observateur
+     */
+    void removeEventObserver(EventObserver * observer);
+
+    /*!
+     * \brief Méthode sauvegardant l'état complet de la partie.
+     *
+     * L'instantané contient la grille, la position du sac et l'état de son
+     * générateur, la \ref Bric courante, le score et les lignes du \ref Player,
+     * le niveau et l'état de la partie. Sa prise ne fait aucune allocation.
+     *
+     * \return l'instantané de la partie
+     */
+    virtual GameSnapshot capture() const;
+
+    /*!
+     * \brief Méthode remettant la partie dans l'état d'un instantané.
+     *
+     * Les parties jouées ensuite avec les mêmes actions sont les mêmes qu'après
+     * la prise de l'instantané. Toute la grille est marquée comme modifiée,
+     * et la \ref Bric courante comme nouvellement mise en jeu.
+     *
+     * \param snapshot l'instantané, pris dans une partie de même grille et de même sac
+     * \throw std::invalid_argument si l'instantané ne correspond pas à la grille ou au sac,
+     *              ou si sa grille, son sac ou sa \ref Bric courante sont incohérents
+     */
+    virtual void restore(const GameSnapshot & snapshot);
+
+    /*!
+     * \brief Accesseur en lecture du niveau de difficulté.
+     * \return le niveau de difficulté
+     */
+    unsigned getLevel() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'intervalle entre deux descentes automatiques.
+     *
+     * Il est calculé à partir du niveau de départ et du nombre de lignes
+     * remplies, entre \ref MAXIMUM_INTERVAL et \ref MINIMUM_INTERVAL.
+     *
+     * \return l'intervalle en milliseconde
+     */
+    unsigned getInterval() const;
+
+    /*!
+     * \brief Accesseur en lecture du score de victoire.
+     * \return le score de victoire
+     */
+    unsigned getWinScore() const;
+
+    /*!
+     * \brief Accesseur en lecture du nombre de lignes de victoire.
+     * \return le nombre de lignes de victoire
+     */
+    unsigned getWinLines() const;
+
+    /*!
+     * \brief Accesseur en lecture du temps de victoire.
+     * \return le temps de victoire
+     */
+    unsigned getWinTime() const;
+
+    /*!
+     * \brief Accesseur en lecture du \ref Player.
+     * \return le joueur
+     */
+    Player getPlayer() const;
+
+    /*!
+     * \brief Accesseur en lecture du \ref Board.
+     *
+     * La grille n'est pas copiée : la référence reste valide tant que la partie
+     * existe, mais son contenu n'est garanti stable que jusqu'à la prochaine
+     * action du jeu, par exemple pendant un \ref Observer::update.
+     *
+     * \return une vue constante sur la grille de jeu
+     */
+    const Board & getBoard() const;
+
+    /*!
+     * \brief Accesseur en lecture de la prochaine \ref Bric courante.
+     * \return la prochaine brique courante
+     */
+    Bric getNextBric() const;
+
+    /*!
+     * \brief Accesseur en lecture de la \ref Bric courante.
+     * \return La \ref Bric courante
+     */
+    Bric getCurrentBric() const;
+
+    /*!
+     * \brief Accesseur en lecture d'une \ref Bric à venir.
+     *
+     * La référence reste valide tant que le sac n'est pas remplacé.
+     *
+     * \param index le rang de la brique après la brique courante, 0 désignant la prochaine
+     * \return la brique à venir
+     * \throw std::out_of_range si le rang n'est pas inférieur à \ref getPreviewDepth
+     */
+    const Bric & getPreview(unsigned index) const;
+
+    /*!
+     * \brief Méthode cherchant les positions finales que la \ref Bric courante peut atteindre.
+     *
+     * Voir \ref MoveGenerator::generate.
+     *
+     * \return les positions finales distinctes, vide si aucune brique n'est en jeu
+     */
+    std::vector<Placement> getPlacements() const;
+
+    /*!
+     * \brief Accesseur en lecture de la clé de \ref Zobrist de l'état du jeu.
+     *
+     * Elle combine la clé de la grille, tenue à jour par le \ref Board, avec
+     * celles de la \ref Bric courante (brique du sac, orientation et position)
+     * et des briques à venir visibles.
+     *
+     * \return la clé de l'état du jeu
+     */
+    std::uint64_t getHash() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'empreinte de l'état du jeu rangée dans
+     * les points de contrôle d'un \ref Replay.
+     *
+     * Contrairement à \ref getHash, elle ne dépend pas des briques à venir
+     * affichées, que le joueur règle à sa guise, mais tient compte du score
+     * et des lignes.
+     *
+     * \return l'empreinte, sur 16 bits
+     */
+    std::uint16_t getChecksum() const;
+
+    /*!
+     * \brief Accesseur en lecture du \ref GameState.
+     * \return l'état du jeu
+     */
+    GameState getGameState() const;
+
+    /*!
+     * \brief Méthode indiquant si une \ref Bric a été mise en jeu depuis les dernières modifications traitées.
+     *
+     * L'état \ref GameState::NEW_BRIC ne dure que le temps d'une notification :
+     * quand les notifications sont regroupées, les observateurs le lisent ici.
+     *
+     * \return true si une nouvelle brique courante a été générée, false sinon
+     */
+    bool hasNewBric() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'état d'activation de la victoire au score.
+     * \return vrai si la victoire au score est activée, faux sinon
+     */
+    bool hasWinByScore() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'état d'activation de la victoire par lignes.
+     * \return vrai si la victoire par lignes est activée, faux sinon
+     */
+    bool hasWinByLines() const;
+
+    /*!
+     * \brief Accesseur en lecture de l'état d'activation de la victoire au temps.
+     * \return vrai si la victoire au temps est activée, faux sinon
+     */
+    bool hasWinByTime() const;
+
+    /*!
+     * \brief Méthode permettant d'effectuer autant de déplacement
+     * de la \ref Bric courante vers le bas que possible.
+     */
+    void drop();
+
+    /*!
+     * \brief Méthode vérifiant que le mouvement de la \ref Bric courante est valide.
+     *
+     * Elle compare les masques précalculés de la brique à la destination du mouvement
+     * avec les lignes de la grille de jeu, sans copier la brique.
+     *
+     * \param dir la direction vers laquelle la brique est déplacée
+     * \return true si le mouvement peut être effectué, false sinon
+     */
+    bool checkMove(Direction dir);
+
+    /*!
+     * \brief Méthode vérifiant que la rotation de la \ref Bric courante est valide.
+     *
+     * Elle compare les masques précalculés de l'orientation suivante de la brique
+     * avec les lignes de la grille de jeu, sans copier la brique.
+     */
+    void checkRotate();
+
+    /*!
+     * \brief Méthode ajoutant des lignes grises au bas de la grille.
+     *
+     * Le contenu de la grille remonte d'un bloc, la 1ère ligne reçue finissant
+     * la plus haute. La \ref Bric courante reste en place, ou remonte juste assez
+     * pour ne pas être recouverte. La partie est perdue si des cases pleines
+     * sortent par le haut ou si la brique ne trouve pas de place. Elle est
+     * ignorée si la partie n'est pas en cours.
+     *
+     * \param line les abscisses des cases pleines de chaque ligne,
+     * chaque ligne étant terminée par -1
+     * \throw std::out_of_range si une abscisse est hors de la grille
+     */
+    void addLine(const std::vector<int> & line);
+
+protected:
+    /*!
+     * \brief Méthode appelée après chaque modification visible de la partie.
+     *
+     * Elle ne fait rien par défaut, \ref Tetris la redéfinit pour notifier ses \ref Observer.
+     */
+    virtual void changed();
+
+    /*!
+     * \brief Méthode oubliant les cases modifiées du \ref Board et la mise en jeu
+     * d'une \ref Bric, une fois les modifications traitées.
+     */
+    void clearChanges();
+
+    /*!
+     * \brief Méthode modifiant le \ref GameState.
+     *
+     * Cette méthode est appelée lorsque :
+     *  - La partie s'initialise ;
+     *  - La partie commence ;
+     *  - Un joueur perd, si la brique suivante ne peut être mise en jeu par manque de place ;
+     *  - Un joueur gagne, s'il atteint un score suffisant ;
+     *  - Un joueur gagne, s'il réussi à remplir suffisamment de lignes ;
+     *  - La partie s'arrête, après un certain temps, le joueur ayant alors le plus haut score l'emporte.
+     *
+     * Tant que la partie n'est pas finie, \ref changed est appelée. Le nouvel
+     * état est publié par un \ref GameEventKind::STATE_CHANGED s'il diffère du
+     * précédent, l'état passager \ref GameState::NEW_BRIC excepté.
+     *
+     * \param gameState le nouvel état de la partie
+     */
+    virtual void setGameState(GameState gameState);
+
+    /*!
+     * \brief Méthode plaçant une nouvelle \ref Bric en haut du \ref Board.
+     *
+     * À la 1ère génération, les couleurs du sac sont ajoutées à la palette
+     * de la grille par \ref internBag.
+     *
+     * \param first indique s'il s'agit de la 1ère génération de brique de la partie
+     */
+    void generateBric(bool first = false);
+
+    /*!
+     * \brief Méthode vérifiant que des lignes ont été remplies.
+     *
+     * Elle est lancée à chaque fois que la \ref Bric courrante
+     * ne peut plus descendre. Les lignes vidées sont mémorisées dans
+     * \ref clearedRows_.
+     *
+     * \param dropsCount le nombre de cases traversées par un drop
+     * \return le nombre de lignes remplies
+     */
+    virtual unsigned checkLines(unsigned dropsCount);
+
+    /*!
+     * \brief Accesseur en lecture des lignes vidées lors du dernier appel à \ref checkLines.
+     * \return le masque des lignes vidées, le bit n°y représentant la ligne y
+     */
+    Column getClearedRows() const;
+
+    /*!
+     * \brief Méthode transmettant un événement aux \ref EventObserver abonnés à sa sorte.
+     * \param event l'événement
+     */
+    void publish(const GameEvent & event);
+
+    /*!
+     * \brief Méthode indiquant si un \ref EventObserver est abonné à une sorte d'événements.
+     * \param kind la sorte d'événements
+     * \return true si un événement de cette sorte doit être publié, false sinon
+     */
+    bool isPublished(GameEventKind kind) const;
+
+private:
+    /*!
+     * \brief Méthode de validation d'un instantané avant sa restauration.
+     *
+     * Elle vérifie, sans rien modifier, que l'instantané a la grille et le sac
+     * de la partie, que ses cases, lignes et colonnes concordent, que ses indices
+     * de briques et ses tailles restent dans leurs tableaux, et que la \ref Bric
+     * courante, dans son orientation, tient entièrement dans la grille.
+     *
+     * \param snapshot l'instantané à valider
+     * \throw std::invalid_argument si l'instantané ne peut pas être restauré
+     */
+    void validateSnapshot(const GameSnapshot & snapshot) const;
+
+    /*!
+     * \brief Méthode de validation de la largeur.
+     *
+     * Cette méthode vérifie que la valeur de l'attribut est comprise entre
+     * \ref MINIMUM_WIDTH et \ref MAXIMUM_WIDTH.
+     *
+     * \param width la valeur à valider
+     * \return la valeur validée
+     * \throw std::invalid_argument si
+     *              width \f$\notin\f$ [\ref MINIMUM_WIDTH,
+     *                                          \ref MAXIMUM_WIDTH]
+     */
+    static unsigned validateWidth(unsigned width);
+
+    /*!
+     * \brief Méthode de validation de la hauteur.
+     *
+     * Cette méthode vérifie que la valeur de l'attribut est comprise entre
+     * \ref MINIMUM_HEIGHT et \ref MAXIMUM_HEIGHT.
+     *
+     * \param height la valeur à valider
+     * \return la valeur validée
+     * \throw std::invalid_argument si
+     *              height \f$\notin\f$ [\ref MINIMUM_HEIGHT,
+     *                                          \ref MAXIMUM_HEIGHT]
+     */
+    static unsigned validateHeight(unsigned height);
+
+    /*!
+     * \brief Méthode de validation du score de victoire.
+     *
+     * Cette méthode vérifie que la valeur de l'attribut est comprise entre
+     * \ref MINIMUM_WIN_SCORE et \ref MAXIMUM_WIN_SCORE.
+     *
+     * \param winScore la valeur à valider
+     * \return la valeur validée
+     * \throw std::invalid_argument si
+     *              winScore \f$\notin\f$ [\ref MINIMUM_WIN_SCORE,
+     *                                          \ref MAXIMUM_WIN_SCORE]
+     */
+    static unsigned validateWinScore(unsigned winScore);
+
+    /*!
+     * \brief Méthode de validation du nombre de lignes de victoire.
+     *
+     * Cette méthode vérifie que la valeur de l'attribut est comprise entre
+     * \ref MINIMUM_WIN_LINES et \ref MAXIMUM_WIN_LINES.
+     *
+     * \param winLines la valeur à valider
+     * \return la valeur validée
+     * \throw std::invalid_argument si
+     *              winLines \f$\notin\f$ [\ref MINIMUM_WIN_LINES,
+     *                                          \ref MAXIMUM_WIN_LINES]
+     */
+    static unsigned validateWinLines(unsigned winLines);
+
+    /*!
+     * \brief Méthode de validation du temps de victoire.
+     *
+     * Cette méthode vérifie que la valeur de l'attribut est comprise entre
+     * \ref MINIMUM_WIN_TIME et \ref MAXIMUM_WIN_TIME.
+     *
+     * \param winTime la valeur à valider
+     * \return la valeur validée
+     * \throw std::invalid_argument si
+     *              winTime \f$\notin\f$ [\ref MINIMUM_WIN_TIME,
+     *                                          \ref MAXIMUM_WIN_TIME]
+     */
+    static unsigned validateWinTime(unsigned winTime);
+
+    /*!
+     * \brief Méthode générant un message d'erreur en fonction de l'exception
+     * rencontrée.
+     *
+     * \param label le label du paramètre invalide
+     * \param value la valeur du paramètre invalide
+     * \param min la valeur minimale de l'attribut
+     * \param max la valeur maximale de l'attribut
+     * \return le message d'erreur
+     */
+    static std::string message(const std::string & label, unsigned value, unsigned min, unsigned max);
+
+    /*!
+     * \brief Méthode remplaçant le \ref BricsBag en conservant sa graine, sa politique de tirage
+     * et le nombre de briques visibles.
+     * \param bag le nouveau sac
+     */
+    void replaceBag(BricsBag bag);
+
+    /*!
+     * \brief Méthode ajoutant les couleurs du \ref BricsBag à la palette de la grille.
+     *
+     * Chaque \ref Bric du sac retient l'indice de sa couleur, que ses copies
+     * mises en jeu emportent : la poser ne fait plus que le copier dans les cases.
+     */
+    void internBag();
+
+    /*!
+     * \brief Méthode appliquant la descente automatique de la \ref Bric courante.
+     *
+     * Si la brique ne peut plus descendre, les lignes pleines sont vidées
+     * et une nouvelle brique est générée.
+     */
+    void fall();
+
+    /*!
+     * \brief Méthode permettant une translation de la \ref Bric courante dans une \ref Direction donnée.
+     *
+     * \param direction la direction vers laquelle la brique est déplacée
+     */
+    void moveBric(Direction dir);
+
+    /*!
+     * \brief Méthode permettant de tourner la \ref Bric courante de 90°.
+     */
+    void rotateBric();
+
+    /*!
+     * \brief Méthode décrivant l'orientation et la position de la \ref Bric courante.
+     * \return la position de la brique
+     */
+    Placement getPlacement() const;
+
+    /*!
+     * \brief Méthode publiant un événement concernant la \ref Bric courante.
+     *
+     * \param kind la sorte d'événement
+     * \param from la position de la brique avant son déplacement
+     */
+    void publishBric(GameEventKind kind, const Placement & from);
+
+    /*!
+     * \brief Méthode publiant le score et le nombre de lignes du \ref Player.
+     */
+    void publishScore();
+
+    /*!
+     * \brief Méthode publiant le \ref GameState.
+     */
+    void publishState();
+
+    /*!
+     * \brief Méthode amie de \ref Board, changeant la couleur d'une case.
+     *
+     * Si elle passe à blanc, la case est considérée comme vide.
+     *
+     * \param pos la position à modifier
+     * \param color la couleur à appliquer
+     */
+    void boardSwapCase(Position &pos, Color color);
+};
+
+} // namespace GJ_GW
+
+#endif // SIMULATION_H
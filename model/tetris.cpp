@@ -1,57 +1,42 @@
 #include "tetris.h"
-#include "direction.h"
-#include "linestate.h"
-#include <stdexcept>
 #include <QTimer>
-#include <iostream>
-#include <algorithm>
+#include <chrono>
 
 using namespace GJ_GW;
 
-Tetris::Tetris(): QObject(), level_ {0}, winScore_{validateWinScore(3000)},
-    winLines_{validateWinLines(50)}, winTime_{validateWinTime(300000)},
-    gameState_{GameState::NONE}, board_{Board(validateWidth(10), validateHeight(20))},
-    winByScore_{1}, winByLines_{1}, winByTime_{1}, paused_{1}{
+static_assert(Tetris::MINIMUM_WIDTH == BoardKernel::MINIMUM_WIDTH
+              && Tetris::MAXIMUM_WIDTH == BoardKernel::MAXIMUM_WIDTH
+              && Tetris::MINIMUM_HEIGHT == BoardKernel::MINIMUM_HEIGHT
+              && Tetris::MAXIMUM_HEIGHT == BoardKernel::MAXIMUM_HEIGHT,
+              "chaque taille de grille valide doit avoir ses noyaux spécialisés");
+
+Tetris::Tetris(): QObject(), Simulation(), paused_{1}{
     savedTime_ = 0;
     timer_ = new QTimer(this);
     connect(timer_, SIGNAL(timeout()), this, SLOT(next()));
 }
 
-unsigned Tetris::getLevel() const{
-    unsigned lvl = level_ + (player_.nbLines_/10);
-    return (lvl > 6)? 6 : lvl;
-}
-
-bool Tetris::isPaused() const{
-    return paused_;
-}
-
-unsigned Tetris::getWinScore() const{
-    return winScore_;
-}
-
-unsigned Tetris::getWinLines() const{
-    return winLines_;
-}
-
-unsigned Tetris::getWinTime() const{
-    return winTime_;
-}
-
-Player Tetris::getPlayer() const{
-    return player_;
-}
-
-Bric Tetris::getNextBric() const{
-    return bag_.getNextBric();
+GameSnapshot Tetris::capture() const{
+    GameSnapshot snapshot {Simulation::capture()};
+    snapshot.elapsed = paused_? savedTime_ : savedTime_ + chrono_.elapsed();
+    return snapshot;
 }
 
-Board Tetris::getBoard() const{
-    return board_;
+void Tetris::restore(const GameSnapshot & snapshot){
+    NotificationBatch batch {*this};
+    Simulation::restore(snapshot);
+    savedTime_ = snapshot.elapsed;
+    if(!paused_){
+        chrono_.restart();
+    }
+    timer_->setInterval(getInterval());
+    if(getGameState() > GameState::ON){
+        pause();
+    }
 }
 
-GameState Tetris::getGameState() const{
-    return gameState_;
+bool Tetris::isPaused() const{
+    return paused_;
 }
 
 unsigned Tetris::getTimeElapsed() const{
@@ -59,231 +44,61 @@ unsigned Tetris::getTimeElapsed() const{
     return (savedTime_ + chrono_.elapsed())/1000;
 }
 
-bool Tetris::hasWinByScore() const{
-    return winByScore_;
-}
-
-bool Tetris::hasWinByLines() const{
-    return winByLines_;
-}
-
-bool Tetris::hasWinByTime() const{
-    return winByTime_;
-}
-
-void Tetris::setBag(std::vector<Bric> newBag, bool keepBag){
-    if(keepBag){
-        bag_.add(newBag);
-    } else{
-        bag_ = BricsBag(newBag);
-    }
-}
-
-void Tetris::resetBag(){
-    bag_ = BricsBag();
-}
-
 void Tetris::initGame(std::string name, unsigned width, unsigned height,
                       unsigned winScore, unsigned winLines, unsigned winTime,
                       unsigned level, bool winByScore, bool winByLines,
                       bool winByTime){
-    player_.setPlayer(name);
-    board_ = Board(validateWidth(width), validateHeight(height));
-    winScore_ = validateWinScore(winScore);
-    winLines_ = validateWinLines(winLines);
-    winTime_ = validateWinTime(winTime);
-    winByScore_ = winByScore;
-    winByLines_ = winByLines;
-    winByTime_ = winByTime;
-    level_ = level;
-    timer_->setInterval(MAXIMUM_TIMER);
-    for(unsigned u {0}; u < level; ++u){
-        setTimer();
-    }
+    Simulation::initGame(name, width, height, winScore, winLines, winTime,
+                         level, winByScore, winByLines, winByTime);
+    setSeed(std::chrono::steady_clock::now().time_since_epoch().count());
+    timer_->setInterval(getInterval());
     savedTime_ = 0;
     paused_ = 1;
-    gameState_ = GameState::INITIALIZED;
 }
 
 void Tetris::startGame(){
-    if(gameState_ == GameState::INITIALIZED){
+    if(getGameState() == GameState::INITIALIZED){
+        NotificationBatch batch {*this};
         generateBric(true);
         resume();
     }
 }
 
-unsigned Tetris::validateWidth(unsigned width){
-    if(width < MINIMUM_WIDTH || width > MAXIMUM_WIDTH){
-        throw std::invalid_argument(message("largeur", width, MINIMUM_WIDTH, MAXIMUM_WIDTH));
-    }
-    return width;
+void Tetris::step(Input input){
+    NotificationBatch batch {*this};
+    Simulation::step(input);
 }
 
-unsigned Tetris::validateHeight(unsigned height){
-    if(height < MINIMUM_HEIGHT || height > MAXIMUM_HEIGHT){
-        throw std::invalid_argument(message("hauteur", height, MINIMUM_HEIGHT, MAXIMUM_HEIGHT));
-    }
-    return height;
-}
-
-unsigned Tetris::validateWinScore(unsigned winScore){
-    if(winScore < MINIMUM_WIN_SCORE || winScore > MAXIMUM_WIN_SCORE){
-        throw std::invalid_argument(message("score de victoire", winScore, MINIMUM_WIN_SCORE, MAXIMUM_WIN_SCORE));
-    }
-    return winScore;
+void Tetris::notifyObservers(){
+    Subject::notifyObservers();
+    clearChanges();
 }
 
-unsigned Tetris::validateWinLines(unsigned winLines){
-    if(winLines < MINIMUM_WIN_LINES || winLines > MAXIMUM_WIN_LINES){
-        throw std::invalid_argument(message("nombre de lignes de victoire", winLines, MINIMUM_WIN_LINES, MAXIMUM_WIN_LINES));
-    }
-    return winLines;
+void Tetris::changed(){
+    notify();
 }
 
-unsigned Tetris::validateWinTime(unsigned winTime){
-    if(winTime < MINIMUM_WIN_TIME || winTime > MAXIMUM_WIN_TIME){
-        throw std::invalid_argument(message("temps de victoire", winTime, MINIMUM_WIN_TIME, MAXIMUM_WIN_TIME));
-    }
-    return winTime;
-}
-
-std::string Tetris::message(const std::string &label, unsigned value, unsigned min, unsigned max){
-    return label +" non valide : "+ std::to_string(value) +" n'est pas compris entre "+ std::to_string(min) +" et "+ std::to_string(max);
-}
-
-void Tetris::generateBric(bool first){
-    bool ok {1};
-    unsigned count{0};
-    bag_.shuffle(first);
-    currentBric_ = bag_.getCurrentBric();
-    unsigned midBoard = board_.width_/2;
-    unsigned midBric = currentBric_.middle_.getX() + 1;
-
-    for(unsigned u {0}; u < midBoard-midBric; ++u){
-        currentBric_.move(Direction::RIGHT);
-    }
-    while(ok && count < currentBric_.shape_.size()){
-        ok = board_.checkCase(currentBric_.shape_.at(count));
-        ++count;
-    }
-
-    if(ok){
-        for(Position p : currentBric_.shape_){
-            boardSwapCase(p, currentBric_.color_);
-        }
-        setGameState(GameState::NEW_BRIC);
-    } else{
-        setGameState(GameState::LOOSE);
-    }
-}
-
-void Tetris::drop(){
-    unsigned count {0};
-    bool ok {1};
-    while(ok){
-        ok = checkMove(Direction::DOWN);
-        ++count;
-    }
-    checkLines(currentBric_.getHigherY(), count);
-    notifyObservers();
-}
-
-bool Tetris::checkMove(Direction dir){
-    bool ok {1};
-    unsigned count {0};
-    Bric destination = currentBric_;
-    destination.move(dir);
-    while(ok && count < destination.shape_.size()){
-        if(! currentBric_.contains(destination.shape_.at(count))){
-            ok = board_.checkCase(destination.shape_.at(count));
-        }
-        ++count;
-    }
-    if(ok)
-        moveBric(dir);
-    return ok;
-}
-
-void Tetris::checkRotate(){
-    bool ok {1};
-    unsigned count {0};
-    Bric destination = currentBric_;
-    destination.rotate();
-    while(ok && count < destination.shape_.size()){
-        if(! currentBric_.contains(destination.shape_.at(count))){
-            ok = board_.checkCase(destination.shape_.at(count));
-        }
-        ++count;
-    }
-    if(ok){
-        rotateBric();
-    }
-}
-
-void Tetris::rotateBric(){
-    for(Position p : currentBric_.shape_){
-        boardSwapCase(p, Color());
-    }
-    currentBric_.rotate();
-    for(Position p : currentBric_.shape_){
-        boardSwapCase(p, currentBric_.color_);
-    }
-    notifyObservers();
-}
-
-void Tetris::moveBric(Direction dir){
-    for(Position p : currentBric_.shape_){
-        boardSwapCase(p, Color());
-    }
-    currentBric_.move(dir);
-    for(Position p : currentBric_.shape_){
-        boardSwapCase(p, currentBric_.color_);
+void Tetris::setGameState(GameState gameState){
+    Simulation::setGameState(gameState);
+    if(gameState > GameState::ON){
+        pause();
     }
-    if(dir != Direction::DOWN)
-        notifyObservers();
 }
 
-unsigned Tetris::checkLines(unsigned top, unsigned dropsCount){
-    unsigned linesFilled;
-    linesFilled = board_.checkColumn(top);
-    if(player_.setNbLines(linesFilled))
-        setLevel();
-    player_.setScore(dropsCount, linesFilled);
-    if(player_.score_ >= winScore_){
-        if(winByScore_)
-            setGameState(GameState::SCORE);
-    } else if(player_.nbLines_ >= winLines_){
-        if(winByLines_)
-            setGameState(GameState::LINE);
-    }
+unsigned Tetris::checkLines(unsigned dropsCount){
+    unsigned linesFilled {Simulation::checkLines(dropsCount)};
+    if(linesFilled > 0)
+        timer_->setInterval(getInterval());
     return linesFilled;
 }
 
-void Tetris::setGameState(GameState gameState){
-    gameState_ = gameState;
-    if(gameState_ > GameState::ON){
-        pause();
-    } else{
-        notifyObservers();
-    }
-    if(gameState_ == GameState::NEW_BRIC){
-        setGameState(GameState::ON);
-    }
-}
-
 void Tetris::next(){
     unsigned timeElapsed {getTimeElapsed()};
-    if(timeElapsed < winTime_ || !winByTime_){
-        if(! checkMove(Direction::DOWN)){
-            checkLines(currentBric_.getHigherY(), 0);
-            if(gameState_ == GameState::ON){
-                generateBric();
-            }
-        }
-        notifyObservers();
+    if(timeElapsed < getWinTime() || !hasWinByTime()){
+        step(Input::NONE);
     } else{
-        if(winByTime_)
-            setGameState(GameState::TIME);
+        NotificationBatch batch {*this};
+        timeOut();
     }
 }
 
@@ -292,7 +107,7 @@ void Tetris::pause(){
         savedTime_ += chrono_.elapsed();
         timer_->stop();
         paused_ = 1;
-        notifyObservers();
+        notify();
     }
 }
 
@@ -301,59 +116,15 @@ void Tetris::resume(){
         chrono_.restart();
         timer_->start();
         paused_ = 0;
-        notifyObservers();
-    }
-}
-
-void Tetris::setLevel(){
-    timer_->setInterval(MAXIMUM_TIMER);
-    for(unsigned u {0}; u < level_+(player_.nbLines_/10); ++u){
-        if(timer_->interval() > MINIMUM_TIMER)
-            setTimer();
-    }
-}
-
-void Tetris::setTimer(){
-    timer_->setInterval(timer_->interval()-200);
-    if(timer_->interval() < MINIMUM_TIMER)
-        timer_->setInterval(MINIMUM_TIMER);
-}
-
-
-
-void Tetris::boardSwapCase(Position &pos, Color color){
-    board_.swapCase(pos, color);
-}
-
-Bric Tetris::getCurrentBric() const{
-    return currentBric_;
-}
-
-std::vector<unsigned> Tetris::getCurrentBricY() const{
-    std::vector<unsigned> tempY;
-    for(Position p : currentBric_.shape_){
-        tempY.push_back(p.getY());
+        notify();
     }
-    std::sort(tempY.begin(), tempY.end(), std::greater<int>());
-    tempY.erase(std::unique(tempY.begin(), tempY.end()), tempY.end());
-    return tempY;
 }
 
 void Tetris::addLine(QList<QString> line){
-    std::vector<unsigned> grey{128,128,128};
-    Color greyColor(grey);
-    for(int i{0}; i < line.count(QString::number(-1)); ++i){
-        for(unsigned u {0}; u < board_.getHeight(); ++u){
-            LineState state {board_.checkRow(u)};
-            if(state != LineState::EMPTY) {
-                board_.moveLine(u,-1, currentBric_);
-            }
-        }
-        unsigned count = 0;
-        while(count < board_.getWidth() && line.at(count).toInt() != -1){
-            Position pos(line.at(count).toInt(), (board_.getHeight()-1));
-            boardSwapCase(pos, greyColor);
-            ++count;
-        }
+    std::vector<int> columns;
+    for(const QString & column : line){
+        columns.push_back(column.toInt());
     }
+    NotificationBatch batch {*this};
+    Simulation::addLine(columns);
 }
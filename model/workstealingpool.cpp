@@ -0,0 +1,93 @@
+#include "workstealingpool.h"
+#include <stdexcept>
+
+using namespace GJ_GW;
+
+WorkStealingPool::WorkStealingPool(unsigned threads): pending_{0}, queued_{0}, next_{0}, stop_{false}{
+    if(threads == 0){
+        throw std::invalid_argument("le groupe doit compter au moins un thread");
+    }
+    for(unsigned u {0}; u < threads; ++u){
+        queues_.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for(unsigned u {0}; u < threads; ++u){
+        threads_.emplace_back(&WorkStealingPool::work, this, u);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool(){
+    wait();
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        stop_ = true;
+    }
+    wakeUp_.notify_all();
+    for(std::thread & thread : threads_){
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task){
+    Queue & queue {*queues_[next_++ % queues_.size()]};
+    ++pending_;
+    {
+        std::lock_guard<std::mutex> lock {queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    std::lock_guard<std::mutex> lock {mutex_};
+    ++queued_;
+    wakeUp_.notify_one();
+}
+
+void WorkStealingPool::wait(){
+    std::unique_lock<std::mutex> lock {mutex_};
+    done_.wait(lock, [this]{ return pending_ == 0; });
+}
+
+unsigned WorkStealingPool::getSize() const{
+    return threads_.size();
+}
+
+void WorkStealingPool::work(unsigned index){
+    std::function<void()> task;
+    while(true){
+        if(take(index, task)){
+            task();
+            task = nullptr;
+            if(--pending_ == 0){
+                std::lock_guard<std::mutex> lock {mutex_};
+                done_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock {mutex_};
+        wakeUp_.wait(lock, [this]{ return stop_ || queued_ > 0; });
+        if(stop_ && queued_ <= 0){
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::take(unsigned index, std::function<void()> & task){
+    {
+        Queue & own {*queues_[index]};
+        std::lock_guard<std::mutex> lock {own.mutex};
+        if(!own.tasks.empty()){
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    for(unsigned u {1}; u < queues_.size(); ++u){
+        Queue & victim {*queues_[(index + u) % queues_.size()]};
+        std::lock_guard<std::mutex> lock {victim.mutex};
+        if(!victim.tasks.empty()){
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,129 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe représentant un groupe de threads à vol de tâches.
+ *
+ * Chaque thread possède sa propre file de tâches, qu'il vide par la fin.
+ * Un thread dont la file est vide vole les tâches des autres par le début,
+ * ce qui équilibre la charge lorsque les tâches ont des durées très différentes,
+ * comme des parties de Tetris.
+ */
+class WorkStealingPool{
+    /*!
+     * \brief Structure représentant la file de tâches d'un thread.
+     */
+    struct Queue{
+        std::mutex mutex;
+        /*!< Le verrou protégeant la file. */
+
+        std::deque<std::function<void()>> tasks;
+        /*!< Les tâches en attente. */
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    /*!< Les files de tâches, une par thread. */
+
+    std::vector<std::thread> threads_;
+    /*!< Les threads du groupe. */
+
+    std::atomic<unsigned> pending_;
+    /*!< Le nombre de tâches soumises et pas encore terminées. */
+
+    std::atomic<int> queued_;
+    /*!< Le nombre de tâches soumises et pas encore prises par un thread.
+     *
+     * Il peut être brièvement négatif, entre le dépôt d'une tâche et son décompte.
+     */
+
+    std::atomic<unsigned> next_;
+    /*!< La file qui recevra la prochaine tâche soumise. */
+
+    bool stop_;
+    /*!< Vrai si les threads doivent s'arrêter, protégé par \ref mutex_. */
+
+    std::mutex mutex_;
+    /*!< Le verrou des attentes sur \ref wakeUp_ et \ref done_. */
+
+    std::condition_variable wakeUp_;
+    /*!< Réveille les threads lorsqu'une tâche est soumise ou que le groupe s'arrête. */
+
+    std::condition_variable done_;
+    /*!< Réveille \ref wait lorsque toutes les tâches sont terminées. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref WorkStealingPool.
+     *
+     * \param threads le nombre de threads, au moins 1
+     * \throw std::invalid_argument si le nombre de threads est nul
+     */
+    explicit WorkStealingPool(unsigned threads);
+
+    /*!
+     * \brief Destructeur de \ref WorkStealingPool.
+     *
+     * Il attend la fin des tâches soumises puis arrête les threads.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+    /*!
+     * \brief Méthode soumettant une tâche au groupe.
+     *
+     * Les tâches sont réparties à tour de rôle dans les files des threads.
+     *
+     * \param task la tâche à exécuter
+     */
+    void submit(std::function<void()> task);
+
+    /*!
+     * \brief Méthode attendant la fin de toutes les tâches soumises.
+     */
+    void wait();
+
+    /*!
+     * \brief Accesseur en lecture du nombre de threads.
+     * \return le nombre de threads du groupe
+     */
+    unsigned getSize() const;
+
+private:
+    /*!
+     * \brief Méthode exécutée par chaque thread du groupe.
+     * \param index l'indice de la file du thread
+     */
+    void work(unsigned index);
+
+    /*!
+     * \brief Méthode cherchant la prochaine tâche d'un thread.
+     *
+     * La tâche est prise à la fin de la file du thread ou, à défaut,
+     * volée au début de la file d'un autre thread.
+     *
+     * \param index l'indice de la file du thread
+     * \param task la tâche trouvée
+     * \return true si une tâche a été trouvée, false sinon
+     */
+    bool take(unsigned index, std::function<void()> & task);
+};
+
+} // namespace GJ_GW
+
+#endif // WORKSTEALINGPOOL_H
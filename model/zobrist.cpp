@@ -0,0 +1,30 @@
+#include "zobrist.h"
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Méthode remplissant la table des clés des cases.
+ * \return les clés, tirées de la graine fixe
+ */
+template<std::size_t N>
+std::array<std::uint64_t, N> makeCells(){
+    std::array<std::uint64_t, N> cells;
+    for(std::size_t i {0}; i < N; ++i){
+        cells[i] = Zobrist::key(i);
+    }
+    return cells;
+}
+
+} // namespace
+
+const std::array<std::uint64_t, Zobrist::WIDTH * Zobrist::HEIGHT> Zobrist::CELLS
+        {makeCells<Zobrist::WIDTH * Zobrist::HEIGHT>()};
+
+std::uint64_t Zobrist::key(std::uint64_t feature){
+    std::uint64_t z {(feature + 1) * 0x9e3779b97f4a7c15ull};
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
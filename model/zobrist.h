@@ -0,0 +1,80 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "row.h"
+#include <array>
+#include <cstdint>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Classe fournissant les clés de Zobrist des états de jeu.
+ *
+ * Chaque case de la grille a sa clé aléatoire de 64 bits : la clé d'une grille
+ * est le OU exclusif des clés de ses cases pleines, ce qui permet de la tenir
+ * à jour en ne traitant que les cases modifiées. Les autres éléments de l'état
+ * (brique courante, briques à venir) ont une clé dérivée de leur description
+ * par \ref key.
+ *
+ * Les clés sont tirées d'une graine fixe : elles sont les mêmes à chaque exécution.
+ */
+class Zobrist{
+    constexpr static unsigned WIDTH {sizeof(Row) * 8};
+    /*!< Le nombre de colonnes disposant d'une clé, le nombre de bits d'une \ref Row. */
+
+    constexpr static unsigned HEIGHT {sizeof(Column) * 8};
+    /*!< Le nombre de lignes disposant d'une clé, le nombre de bits d'une \ref Column. */
+
+    static const std::array<std::uint64_t, WIDTH * HEIGHT> CELLS;
+    /*!< Les clés des cases, rangées ligne par ligne. */
+
+public:
+    /*!
+     * \brief Méthode renvoyant la clé d'une case.
+     *
+     * \param x l'abscisse de la case
+     * \param y l'ordonnée de la case
+     * \return la clé de la case
+     */
+    inline static std::uint64_t cell(unsigned x, unsigned y);
+
+    /*!
+     * \brief Méthode renvoyant la clé d'un ensemble de cases d'une ligne.
+     *
+     * La clé de la différence de deux lignes est le OU exclusif de leurs clés.
+     *
+     * \param y l'ordonnée de la ligne
+     * \param mask les cases, le bit n°x représentant la case d'abscisse x
+     * \return le OU exclusif des clés des cases
+     */
+    inline static std::uint64_t row(unsigned y, Row mask);
+
+    /*!
+     * \brief Méthode renvoyant la clé d'un élément de l'état décrit par un entier.
+     *
+     * \param feature la description de l'élément
+     * \return la clé de l'élément, obtenue par le mélange de splitmix64
+     */
+    static std::uint64_t key(std::uint64_t feature);
+};
+
+//méthodes inline
+
+std::uint64_t Zobrist::cell(unsigned x, unsigned y){
+    return CELLS[y * WIDTH + x];
+}
+
+std::uint64_t Zobrist::row(unsigned y, Row mask){
+    std::uint64_t result {0};
+    for(unsigned bits {mask}; bits != 0; bits &= bits - 1){
+        result ^= cell(__builtin_ctz(bits), y);
+    }
+    return result;
+}
+
+} // namespace GJ_GW
+
+#endif // ZOBRIST_H
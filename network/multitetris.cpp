@@ -88,7 +88,7 @@ void MultiTetris::sendReady(){
 
 void MultiTetris::setReady(){
     ready_ = true;
-    notifyObservers();
+    notify();
 }
 
 void MultiTetris::cancelGame(){
@@ -128,6 +128,7 @@ void MultiTetris::initGame(std::string name, unsigned width, unsigned height,
         args.append(QString::number(hasWinByScore()));
         args.append(QString::number(hasWinByLines()));
         args.append(QString::number(hasWinByTime()));
+        args.append(QString::number(getSeed()));
         NetMsg netMsg(NetMsg::MSG_FIRST, args);
         client_->sendData(netMsg);
     }
@@ -135,6 +136,7 @@ void MultiTetris::initGame(std::string name, unsigned width, unsigned height,
 
 void MultiTetris::startGame(){
     if(getGameState() == GameState::INITIALIZED){
+        NotificationBatch batch {*this};
         generateBric(true);
         Tetris::resume();
     }
@@ -176,15 +178,19 @@ void MultiTetris::endGame(int endState){
     Tetris::setGameState(static_cast<GameState>(endState));
 }
 
-unsigned MultiTetris::checkLines(unsigned top, unsigned dropsCount){
-    unsigned linesFilled {Tetris::checkLines(top, dropsCount)};
+unsigned MultiTetris::checkLines(unsigned dropsCount){
+    unsigned linesFilled {Tetris::checkLines(dropsCount)};
     if((mode_ == GameMode::CLIENT || mode_ == GameMode::HOST) && linesFilled > 1){
         QList<QString> line;
-        std::vector<unsigned> bricY = getCurrentBricY();
+        Column cleared {getClearedRows()};
+        const Bric bric {getCurrentBric()};
+        const unsigned width {getBoard().getWidth()};
         for(unsigned u{0}; u < linesFilled-1; ++u){
-            for(unsigned v{0}; v < getBoard().getWidth(); ++v){
-                Position pos(v, bricY.at(u));
-                if(!getCurrentBric().contains(pos)){
+            unsigned y = 31 - __builtin_clz(cleared);      // de la ligne la plus basse à la plus haute
+            cleared &= ~(Column(1) << y);
+            for(unsigned v{0}; v < width; ++v){
+                Position pos(v, y);
+                if(!bric.contains(pos)){
                     line.append(QString::number(v));
                 }
             }
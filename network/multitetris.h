@@ -138,10 +138,12 @@ protected:
     /*!
      * \brief Méthode qui permet de savoir quel ligne envoyer chez l'adversaire.
      *
-     * \param top où commencer à check si la ligne est complète
+     * Les lignes envoyées sont celles vidées par la \ref Bric courante,
+     * privées des cases de cette brique.
+     *
      * \param dropsCount le nombre de drop à compter
      */
-    unsigned checkLines(unsigned top, unsigned dropsCount) override;
+    unsigned checkLines(unsigned dropsCount) override;
 };
 
 } // namespace GJ_GW
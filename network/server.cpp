@@ -124,6 +124,9 @@ void Server::reactToFirstMsg(NetMsg &netMsg){
                         netMsg.get(3).toUInt(), netMsg.get(4).toUInt(), netMsg.get(5).toUInt(),
                         netMsg.get(6).toUInt(), netMsg.get(7).toInt(),
                         netMsg.get(8).toInt(), netMsg.get(9).toInt());
+        if(netMsg.getBody().size() > 10){
+            game_->setSeed(netMsg.get(10).toULongLong());
+        }
         NetMsg netMsg(NetMsg::ACK_FIRST);
         sendData(netMsg);
         game_->setMode(GameMode::HOST);
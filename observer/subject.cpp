@@ -1,5 +1,6 @@
 #include "subject.h"
 #include "observer.h"
+#include <stdexcept>
 
 using namespace GJ_GW;
 
@@ -20,3 +21,42 @@ void Subject::notifyObservers()
         o->update(this);
     }
 }
+
+void Subject::beginBatch()
+{
+    ++batch_;
+}
+
+void Subject::endBatch()
+{
+    if (batch_ == 0)
+    {
+        throw std::logic_error("aucun lot de notifications n'est ouvert");
+    }
+    if (--batch_ == 0 && pending_)
+    {
+        pending_ = 0;
+        notifyObservers();
+    }
+}
+
+void Subject::notify()
+{
+    if (batch_ > 0)
+    {
+        pending_ = 1;
+    } else
+    {
+        notifyObservers();
+    }
+}
+
+NotificationBatch::NotificationBatch(Subject & subject): subject_(subject)
+{
+    subject_.beginBatch();
+}
+
+NotificationBatch::~NotificationBatch()
+{
+    subject_.endBatch();
+}
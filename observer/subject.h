@@ -12,12 +12,23 @@ class Observer;
 
 /*!
  * \brief Classe abstraite représentant un sujet d'observation du Design Pattern Observer.
+ *
+ * Les notifications peuvent être regroupées en lots : entre \ref beginBatch et
+ * \ref endBatch, les demandes faites par \ref notify sont seulement retenues,
+ * et les \ref Observer ne sont notifiés qu'une fois, à la fin du lot.
  */
 class Subject{
 protected:
     std::set<Observer *> observers_;
     /*!< La liste des \ref Observer de \ref Subject. */
 
+private:
+    unsigned batch_ {0};
+    /*!< Le nombre de lots de notifications ouverts. */
+
+    bool pending_ {0};
+    /*!< Une notification a-t-elle été demandée pendant le lot en cours. */
+
 public:
     virtual ~Subject() = default;
 
@@ -33,9 +44,35 @@ public:
      */
     virtual void removeObserver(Observer * observer);
 
+    /*!
+     * \brief Méthode ouvrant un lot de notifications.
+     *
+     * Les lots peuvent être imbriqués : seule la fin du lot le plus
+     * extérieur notifie les \ref Observer.
+     */
+    void beginBatch();
+
+    /*!
+     * \brief Méthode fermant un lot de notifications.
+     *
+     * Si c'est le lot le plus extérieur et qu'une notification a été
+     * demandée pendant le lot, les \ref Observer sont notifiés une fois.
+     *
+     * \throw std::logic_error si aucun lot n'est ouvert
+     */
+    void endBatch();
+
 protected:
     Subject() = default;
 
+    /*!
+     * \brief Méthode demandant la notification des \ref Observer.
+     *
+     * Hors d'un lot, ils sont notifiés immédiatement ; pendant un lot, ils
+     * le seront à sa fin.
+     */
+    void notify();
+
     /*!
      * \brief Méthode abstraite permettant de demander à tous les \ref Observer
      * de faire une mise à jour des données.
@@ -43,6 +80,31 @@ protected:
     virtual void notifyObservers();
 };
 
+/*!
+ * \brief Classe ouvrant un lot de notifications d'un \ref Subject pour la durée de sa vie.
+ *
+ * Le lot est fermé même si l'opération qu'il couvre lance une exception.
+ */
+class NotificationBatch{
+    Subject & subject_;
+    /*!< Le sujet dont les notifications sont regroupées. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref NotificationBatch, ouvrant le lot.
+     * \param subject le sujet dont les notifications sont regroupées
+     */
+    explicit NotificationBatch(Subject & subject);
+
+    /*!
+     * \brief Destructeur de \ref NotificationBatch, fermant le lot.
+     */
+    ~NotificationBatch();
+
+    NotificationBatch(const NotificationBatch &) = delete;
+    NotificationBatch & operator=(const NotificationBatch &) = delete;
+};
+
 } // namespace GJ_GW
 
 #endif // SUBJECT_H
@@ -22,15 +22,31 @@ SOURCES += model/board.cpp \
     observer/subject.cpp \
     view/configdialog.cpp \
     view/mwtetris.cpp \
+    view/boardwidget.cpp \
     model/tetris.cpp \
+    model/simulation.cpp \
+    model/random.cpp \
     view/setbricsdialog.cpp \
     main.cpp \
     model/color.cpp \
+    model/palette.cpp \
+    model/boardkernel.cpp \
+    model/movegenerator.cpp \
+    model/zobrist.cpp \
+    model/replay.cpp \
+    model/replayarchive.cpp \
+    model/mappedfile.cpp \
+    model/eventqueue.cpp \
+    model/workstealingpool.cpp \
     network/multitetris.cpp \
     network/server.cpp \
     network/client.cpp \
     network/netmsg.cpp \
-    view/confirmlaunchdialog.cpp
+    view/confirmlaunchdialog.cpp \
+    bot/beamsearch.cpp \
+    bot/evaluator.cpp \
+    bot/transpositiontable.cpp \
+    bot/botplayer.cpp
 
 HEADERS  += model/board.h \
     model/bric.h \
@@ -41,18 +57,40 @@ HEADERS  += model/board.h \
     observer/subject.h \
     view/configdialog.h \
     view/mwtetris.h \
+    view/boardwidget.h \
     model/tetris.h \
+    model/simulation.h \
+    model/input.h \
+    model/random.h \
+    model/bagpolicy.h \
     model/direction.h \
     view/setbricsdialog.h \
-    model/linestate.h \
     model/gamestate.h \
     model/color.h \
+    model/row.h \
+    model/palette.h \
+    model/boardkernel.h \
+    model/movegenerator.h \
+    model/placement.h \
+    model/zobrist.h \
+    model/gamesnapshot.h \
+    model/replay.h \
+    model/replayarchive.h \
+    model/mappedfile.h \
+    model/gameevent.h \
+    model/eventobserver.h \
+    model/eventqueue.h \
+    model/workstealingpool.h \
     network/multitetris.h \
     network/server.h \
     network/client.h \
     network/netmsg.h \
     view/confirmlaunchdialog.h \
-    network/gamemode.h
+    network/gamemode.h \
+    bot/beamsearch.h \
+    bot/evaluator.h \
+    bot/transpositiontable.h \
+    bot/botplayer.h
 
 FORMS    += view/configdialog.ui \
     view/mwtetris.ui \
@@ -0,0 +1,38 @@
+#-------------------------------------------------
+#
+# Compteur des allocations d'une partie, sans Qt
+#
+#-------------------------------------------------
+
+TARGET = alloc
+TEMPLATE = app
+CONFIG += console C++14 thread
+CONFIG -= qt app_bundle
+
+SOURCES += main.cpp \
+    ../../model/board.cpp \
+    ../../model/boardkernel.cpp \
+    ../../model/bric.cpp \
+    ../../model/bricsBag.cpp \
+    ../../model/movegenerator.cpp \
+    ../../model/color.cpp \
+    ../../model/palette.cpp \
+    ../../model/player.cpp \
+    ../../model/position.cpp \
+    ../../model/random.cpp \
+    ../../model/simulation.cpp \
+    ../../model/zobrist.cpp \
+    ../../model/replay.cpp \
+    ../../model/replayarchive.cpp \
+    ../../model/mappedfile.cpp \
+    ../../model/workstealingpool.cpp \
+    ../../bot/beamsearch.cpp \
+    ../../bot/evaluator.cpp \
+    ../../bot/transpositiontable.cpp
+
+HEADERS += ../../model/simulation.h \
+    ../../model/movegenerator.h \
+    ../../model/workstealingpool.h \
+    ../../bot/beamsearch.h \
+    ../../bot/evaluator.h \
+    ../../bot/transpositiontable.h
@@ -0,0 +1,199 @@
+#include "../../model/simulation.h"
+#include "../../model/movegenerator.h"
+#include "../../bot/beamsearch.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Le nombre d'allocations faites depuis le lancement du programme.
+ */
+unsigned long long allocations {0};
+
+/*!
+ * \brief Méthode affichant l'utilisation du programme.
+ * \param name le nom du programme
+ */
+void usage(const char * name){
+    std::cerr << "Utilisation : " << name << " [options]\n"
+              << "  -n <parties>     nombre de parties (10)\n"
+              << "  -s <graine>      graine de la première partie (1)\n"
+              << "  -m <pas>         nombre maximal de pas par partie (20000)\n"
+              << "  --size <LxH>     taille de grille (10x20)\n";
+}
+
+/*!
+ * \brief Méthode convertissant un argument en entier positif.
+ * \param text l'argument
+ * \return l'entier
+ * \throw std::invalid_argument si l'argument n'est pas un entier positif
+ */
+unsigned toUnsigned(const std::string & text){
+    std::size_t end;
+    unsigned long value {std::stoul(text, &end)};
+    if(end != text.size()){
+        throw std::invalid_argument("nombre non valide : " + text);
+    }
+    return value;
+}
+
+/*!
+ * \brief Méthode préparant une partie sans Qt.
+ * \param game la partie
+ * \param seed la graine du sac
+ * \param width la largeur de la grille
+ * \param height la hauteur de la grille
+ */
+void start(Simulation & game, unsigned seed, unsigned width, unsigned height){
+    game.setSeed(seed);
+    game.initGame("alloc", width, height, Simulation::MAXIMUM_WIN_SCORE, Simulation::MAXIMUM_WIN_LINES,
+                  Simulation::MAXIMUM_WIN_TIME, 0, 0, 0, 0);
+    game.startGame();
+}
+
+/*!
+ * \brief Méthode écrivant le script d'une partie, jouée par une \ref BeamSearch.
+ *
+ * Le robot alloue librement : seules les actions qu'il choisit sont gardées.
+ *
+ * \param seed la graine du sac
+ * \param width la largeur de la grille
+ * \param height la hauteur de la grille
+ * \param maxSteps le nombre maximal d'actions
+ * \return les actions, descentes automatiques comprises
+ */
+std::vector<Input> script(unsigned seed, unsigned width, unsigned height, unsigned maxSteps){
+    Simulation game;
+    start(game, seed, width, height);
+    const BeamSearch search {4};
+    std::vector<Input> script;
+    std::vector<Input> inputs;
+    while(script.size() < maxSteps && game.getGameState() == GameState::ON){
+        std::vector<Placement> plan {search.search(game.getBoard(), game.getCurrentBric(), true,
+                                                   {game.getPreview(0)})};
+        if(plan.empty() || !MoveGenerator::path(game.getBoard(), game.getCurrentBric(), true,
+                                                plan.front(), inputs)){
+            inputs.assign(1, Input::DROP);
+        }
+        // la brique droppée n'est fixée qu'à la descente suivante
+        inputs.push_back(Input::NONE);
+        for(Input input : inputs){
+            game.step(input);
+        }
+        script.insert(script.end(), inputs.begin(), inputs.end());
+    }
+    return script;
+}
+
+} // namespace
+
+/*!
+ * \brief Remplacement de l'allocation globale, qui compte chaque appel.
+ */
+void * operator new(std::size_t size){
+    ++allocations;
+    if(void * memory = std::malloc(size ? size : 1)){
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void operator delete(void * memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete[](void * memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete(void * memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+void operator delete[](void * memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+/*!
+ * \brief Programme vérifiant qu'une partie sans Qt n'alloue plus rien une fois lancée.
+ *
+ * Chaque partie est d'abord jouée par une \ref BeamSearch pour en écrire le
+ * script, puis rejouée pas à pas dans une nouvelle \ref Simulation de même
+ * graine : les allocations sont comptées pendant chaque appel à
+ * \ref Simulation::step, briques mises en jeu et lignes vidées comprises.
+ *
+ * \return 0 si aucun pas n'a alloué, 2 sinon, 1 en cas d'erreur
+ */
+int main(int argc, char * argv[]){
+    try{
+        unsigned games {10};
+        unsigned seed {1};
+        unsigned maxSteps {20000};
+        unsigned width {10};
+        unsigned height {20};
+        for(int i {1}; i < argc; ++i){
+            std::string arg {argv[i]};
+            if(i + 1 >= argc){
+                usage(argv[0]);
+                return 1;
+            }
+            std::string value {argv[++i]};
+            if(arg == "-n"){
+                games = toUnsigned(value);
+            } else if(arg == "-s"){
+                seed = toUnsigned(value);
+            } else if(arg == "-m"){
+                maxSteps = toUnsigned(value);
+            } else if(arg == "--size"){
+                std::size_t x {value.find('x')};
+                if(x == std::string::npos){
+                    throw std::invalid_argument("taille non valide : " + value);
+                }
+                width = toUnsigned(value.substr(0, x));
+                height = toUnsigned(value.substr(x + 1));
+            } else{
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        unsigned long long steps {0};
+        unsigned long long ticks {0};
+        unsigned long long lines {0};
+        unsigned long long total {0};
+        unsigned long long worst {0};
+        for(unsigned u {0}; u < games; ++u){
+            const std::vector<Input> inputs {script(seed + u, width, height, maxSteps)};
+            Simulation game;
+            start(game, seed + u, width, height);
+            for(Input input : inputs){
+                const unsigned long long before {allocations};
+                game.step(input);
+                const unsigned long long count {allocations - before};
+                total += count;
+                worst = std::max(worst, count);
+                ticks += input == Input::NONE;
+            }
+            steps += inputs.size();
+            lines += game.getPlayer().getNbLines();
+        }
+        std::cout << games << " parties, " << steps << " pas dont " << ticks << " descentes, "
+                  << lines << " lignes remplies\n"
+                  << total << " allocations pendant les pas (" << worst << " au plus par pas), "
+                  << static_cast<double>(total) / (ticks ? ticks : 1) << " par descente\n";
+        return total == 0 ? 0 : 2;
+    } catch(const std::exception & e){
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,217 @@
+#include "batchrunner.h"
+#include "../../model/simulation.h"
+#include "../../model/eventobserver.h"
+#include "../../model/movegenerator.h"
+#include "../../model/workstealingpool.h"
+#include "../../bot/beamsearch.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Classe comptant les briques mises en jeu au cours d'une \ref Simulation.
+ *
+ * Elle n'est abonnée qu'à \ref GameEventKind::PIECE_SPAWNED.
+ */
+class PieceCounter : public EventObserver{
+    unsigned pieces_;
+    /*!< Le nombre de briques mises en jeu. */
+
+public:
+    PieceCounter(): pieces_{0}{}
+
+    /*!
+     * \brief Accesseur en lecture du nombre de briques mises en jeu.
+     * \return le nombre de briques
+     */
+    unsigned getPieces() const{
+        return pieces_;
+    }
+
+    void onEvent(const GameEvent &) override{
+        ++pieces_;
+    }
+};
+
+/*!
+ * \brief Méthode calculant un quantile d'une série triée.
+ *
+ * \param sorted la série, triée par ordre croissant et non vide
+ * \param q le quantile, entre 0 et 1
+ * \return la valeur du quantile
+ */
+unsigned quantile(const std::vector<unsigned> & sorted, double q){
+    return sorted[static_cast<std::size_t>(q * (sorted.size() - 1) + 0.5)];
+}
+
+} // namespace
+
+BatchRunner::BatchRunner(std::vector<std::vector<Bric>> bags): bags_{std::move(bags)}{
+    if(bags_.empty()){
+        throw std::invalid_argument("aucune configuration de sac");
+    }
+}
+
+GameResult BatchRunner::play(const GameConfig & config, Replay * replay) const{
+    Simulation game;
+    PieceCounter counter;
+    game.addEventObserver(&counter, GameEvent::mask(GameEventKind::PIECE_SPAWNED));
+    const std::vector<Bric> & bag {bags_.at(config.bag)};
+    if(!bag.empty()){
+        game.setBag(bag, false);
+    }
+    Replay file;
+    if(!replay && !config.replay.empty()){
+        replay = &file;
+    }
+    game.setRecording(replay);
+    game.setSeed(config.seed);
+    game.setBagPolicy(config.policy);
+    game.initGame("batch", config.width, config.height, Simulation::MAXIMUM_WIN_SCORE,
+                  Simulation::MAXIMUM_WIN_LINES, Simulation::MAXIMUM_WIN_TIME, 0, 0, 0, 0);
+    game.startGame();
+    Random random {~static_cast<std::uint64_t>(config.seed)};
+    unsigned steps {0};
+    if(config.beam != 0){
+        const BeamSearch search {config.beam};
+        std::vector<Input> inputs;
+        while(steps < config.maxSteps && game.getGameState() == GameState::ON){
+            std::vector<Placement> plan {search.search(game.getBoard(), game.getCurrentBric(), true,
+                                                       {game.getPreview(0)})};
+            if(plan.empty() || !MoveGenerator::path(game.getBoard(), game.getCurrentBric(), true,
+                                                    plan.front(), inputs)){
+                inputs.assign(1, Input::DROP);
+            }
+            // la brique droppée n'est fixée qu'à la descente suivante
+            inputs.push_back(Input::NONE);
+            for(Input input : inputs){
+                game.step(input);
+            }
+            steps += inputs.size();
+        }
+    }
+    while(steps < config.maxSteps && game.getGameState() == GameState::ON){
+        game.step(static_cast<Input>(random.below(static_cast<unsigned>(Input::DROP) + 1)));
+        ++steps;
+    }
+    // le nombre de pas tient lieu de temps de victoire : la partie est enregistrée comme finie par le temps
+    game.timeOut();
+    game.finishRecording();
+    if(!config.replay.empty()){
+        std::ofstream out {config.replay, std::ios::binary};
+        replay->save(out);
+        if(!out){
+            throw std::invalid_argument("impossible d'écrire l'enregistrement " + config.replay);
+        }
+    }
+    return GameResult{game.getPlayer().getScore(), game.getPlayer().getNbLines(), counter.getPieces(), steps};
+}
+
+std::vector<GameResult> BatchRunner::run(const std::vector<GameConfig> & configs, unsigned threads,
+                                         std::vector<Replay> * replays) const{
+    std::vector<GameResult> results(configs.size());
+    if(replays){
+        replays->assign(configs.size(), Replay{});
+    }
+    WorkStealingPool pool {threads};
+    for(std::size_t i {0}; i < configs.size(); ++i){
+        pool.submit([this, &configs, &results, replays, i]{
+            results[i] = play(configs[i], replays? &(*replays)[i] : nullptr);
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+std::vector<Bric> BatchRunner::loadBag(const std::string & path){
+    std::ifstream file {path};
+    if(!file){
+        throw std::invalid_argument("impossible de lire le sac " + path);
+    }
+    std::vector<Bric> bag;
+    std::string line;
+    unsigned number {0};
+    while(std::getline(file, line)){
+        ++number;
+        if(line.empty() || line[0] == '#'){
+            continue;
+        }
+        std::istringstream in {line};
+        unsigned red, green, blue;
+        if(!(in >> red >> green >> blue) || red > 255 || green > 255 || blue > 255){
+            throw std::invalid_argument(path + ":" + std::to_string(number) + " : couleur non valide");
+        }
+        std::vector<Position> shape;
+        unsigned x, y;
+        char comma;
+        while(in >> x >> comma >> y){
+            if(comma != ','){
+                throw std::invalid_argument(path + ":" + std::to_string(number) + " : case non valide");
+            }
+            shape.push_back(Position(x, y));
+        }
+        if(!in.eof() || shape.empty()){
+            throw std::invalid_argument(path + ":" + std::to_string(number) + " : case non valide");
+        }
+        bag.push_back(Bric(shape, Color(red, green, blue)));
+    }
+    if(bag.size() < 2){
+        throw std::invalid_argument("le sac " + path + " doit contenir au moins deux briques");
+    }
+    return bag;
+}
+
+void BatchRunner::report(std::ostream & out, const std::vector<GameConfig> & configs,
+                         const std::vector<GameResult> & results, double seconds){
+    unsigned long long pieces {0};
+    unsigned long long steps {0};
+    std::map<std::tuple<unsigned, unsigned, unsigned>, std::vector<const GameResult *>> groups;
+    for(std::size_t i {0}; i < results.size(); ++i){
+        pieces += results[i].pieces;
+        steps += results[i].steps;
+        groups[std::make_tuple(configs[i].width, configs[i].height, configs[i].bag)].push_back(&results[i]);
+    }
+    out << std::fixed << std::setprecision(1)
+        << results.size() << " parties en " << seconds << " s : "
+        << results.size() / seconds << " parties/s, "
+        << pieces / seconds << " briques/s, "
+        << steps / seconds << " pas/s\n\n";
+    out << "taille  sac  parties     score: moyen    min    p10    p50    p90    max   lignes  briques\n";
+    for(const auto & group : groups){
+        std::vector<unsigned> scores;
+        double lines {0};
+        double groupPieces {0};
+        for(const GameResult * result : group.second){
+            scores.push_back(result->score);
+            lines += result->lines;
+            groupPieces += result->pieces;
+        }
+        std::sort(scores.begin(), scores.end());
+        double count = group.second.size();
+        double mean {0};
+        for(unsigned score : scores){
+            mean += score;
+        }
+        std::ostringstream size;
+        size << std::get<0>(group.first) << "x" << std::get<1>(group.first);
+        out << std::left << std::setw(7) << size.str() << std::right
+            << std::setw(4) << std::get<2>(group.first)
+            << std::setw(9) << group.second.size()
+            << std::setw(16) << mean / count
+            << std::setw(7) << scores.front()
+            << std::setw(7) << quantile(scores, 0.1)
+            << std::setw(7) << quantile(scores, 0.5)
+            << std::setw(7) << quantile(scores, 0.9)
+            << std::setw(7) << scores.back()
+            << std::setw(9) << lines / count
+            << std::setw(9) << groupPieces / count << "\n";
+    }
+}
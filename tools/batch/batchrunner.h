@@ -0,0 +1,139 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "../../model/bric.h"
+#include "../../model/bagpolicy.h"
+#include "../../model/replay.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure décrivant une partie à jouer par le \ref BatchRunner.
+ */
+struct GameConfig{
+    unsigned seed;
+    /*!< La graine du sac et des actions du joueur. */
+
+    unsigned width;
+    /*!< La largeur de la grille. */
+
+    unsigned height;
+    /*!< La hauteur de la grille. */
+
+    unsigned bag;
+    /*!< L'indice de la configuration de sac dans le \ref BatchRunner. */
+
+    BagPolicy policy;
+    /*!< La manière de tirer les briques du sac. */
+
+    unsigned maxSteps;
+    /*!< Le nombre maximal de pas de la partie, après lequel elle se termine par \ref Simulation::timeOut. */
+
+    unsigned beam;
+    /*!< La largeur du faisceau de la \ref BeamSearch qui joue la partie,
+     * 0 pour jouer des actions tirées au hasard. */
+
+    std::string replay;
+    /*!< Le fichier où écrire le \ref Replay de la partie, vide pour ne pas l'enregistrer. */
+};
+
+/*!
+ * \brief Structure représentant le résultat d'une partie jouée par le \ref BatchRunner.
+ */
+struct GameResult{
+    unsigned score;
+    /*!< Le score final du joueur. */
+
+    unsigned lines;
+    /*!< Le nombre de lignes remplies. */
+
+    unsigned pieces;
+    /*!< Le nombre de briques mises en jeu. */
+
+    unsigned steps;
+    /*!< Le nombre de pas joués. */
+};
+
+/*!
+ * \brief Classe jouant des parties de Tetris indépendantes sur tous les cœurs.
+ *
+ * Chaque partie est une \ref Simulation sans Qt, jouée par des actions tirées
+ * au hasard à partir de sa propre graine ou par une \ref BeamSearch sans limite
+ * de temps, avec sa propre taille de grille et sa propre configuration de sac. La graine fixe aussi la suite des briques :
+ * rejouer un lot avec les mêmes options donne les mêmes résultats.
+ */
+class BatchRunner{
+    std::vector<std::vector<Bric>> bags_;
+    /*!< Les configurations de sac, un sac vide désignant le sac par défaut. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref BatchRunner.
+     *
+     * \param bags les configurations de sac, un sac vide désignant le sac par défaut
+     * \throw std::invalid_argument s'il n'y a aucune configuration
+     */
+    explicit BatchRunner(std::vector<std::vector<Bric>> bags);
+
+    /*!
+     * \brief Méthode jouant une partie jusqu'à la défaite ou jusqu'au nombre maximal de pas.
+     *
+     * \param config la description de la partie
+     * \param replay l'enregistrement où garder la partie, nullptr pour ne pas la garder en mémoire
+     * \return le résultat de la partie
+     * \throw std::out_of_range si la configuration de sac n'existe pas
+     * \throw std::invalid_argument si la taille de la grille n'est pas valide
+     * ou si l'enregistrement ne peut être écrit
+     */
+    GameResult play(const GameConfig & config, Replay * replay = nullptr) const;
+
+    /*!
+     * \brief Méthode jouant toutes les parties en parallèle.
+     *
+     * Les parties sont réparties sur un \ref WorkStealingPool.
+     *
+     * \param configs les descriptions des parties
+     * \param threads le nombre de threads
+     * \param replays les enregistrements des parties, remplis dans l'ordre des descriptions,
+     * nullptr pour ne pas les garder en mémoire
+     * \return les résultats, dans l'ordre des descriptions
+     */
+    std::vector<GameResult> run(const std::vector<GameConfig> & configs, unsigned threads,
+                                std::vector<Replay> * replays = nullptr) const;
+
+    /*!
+     * \brief Méthode lisant une configuration de sac dans un fichier texte.
+     *
+     * Chaque ligne décrit une brique : les composantes rouge, verte et bleue de
+     * sa couleur suivies des cases qu'elle couvre, sous la forme x,y.
+     * Les lignes vides et celles commençant par # sont ignorées.
+     *
+     * \param path le chemin du fichier
+     * \return les briques du sac
+     * \throw std::invalid_argument si le fichier est illisible ou mal formé
+     */
+    static std::vector<Bric> loadBag(const std::string & path);
+
+    /*!
+     * \brief Méthode écrivant le débit et la distribution des scores d'un lot de parties.
+     *
+     * Les résultats sont regroupés par taille de grille et configuration de sac.
+     *
+     * \param out le flux de sortie
+     * \param configs les descriptions des parties
+     * \param results les résultats des parties
+     * \param seconds la durée du lot en secondes
+     */
+    static void report(std::ostream & out, const std::vector<GameConfig> & configs,
+                       const std::vector<GameResult> & results, double seconds);
+};
+
+} // namespace GJ_GW
+
+#endif // BATCHRUNNER_H
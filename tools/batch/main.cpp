@@ -0,0 +1,138 @@
+#include "batchrunner.h"
+#include "../../model/replayarchive.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Méthode affichant l'utilisation du programme.
+ * \param name le nom du programme
+ */
+void usage(const char * name){
+    std::cerr << "Utilisation : " << name << " [options]\n"
+              << "  -n <parties>     nombre de parties (1000)\n"
+              << "  -j <threads>     nombre de threads (tous les cœurs)\n"
+              << "  -s <graine>      graine de la première partie (1)\n"
+              << "  -m <pas>         nombre de pas après lequel la partie finit par le temps (100000)\n"
+              << "  -p <politique>   tirage des briques : swap, bag ou history (swap)\n"
+              << "  --size <LxH>     taille de grille, répétable (10x20)\n"
+              << "  --bag <fichier>  configuration de sac, répétable (sac par défaut)\n"
+              << "  --bot <largeur>  jouer par recherche en faisceau de cette largeur (0 : au hasard)\n"
+              << "  --replay <dossier> enregistrer chaque partie dans <dossier>/<graine>.gjtr\n"
+              << "  --archive <fichier> enregistrer toutes les parties dans une seule archive\n";
+}
+
+/*!
+ * \brief Méthode convertissant un argument en entier positif.
+ * \param text l'argument
+ * \return l'entier
+ * \throw std::invalid_argument si l'argument n'est pas un entier positif
+ */
+unsigned toUnsigned(const std::string & text){
+    std::size_t end;
+    unsigned long value {std::stoul(text, &end)};
+    if(end != text.size()){
+        throw std::invalid_argument("nombre non valide : " + text);
+    }
+    return value;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]){
+    try{
+        unsigned games {1000};
+        unsigned threads {std::thread::hardware_concurrency()};
+        unsigned seed {1};
+        unsigned maxSteps {100000};
+        unsigned beam {0};
+        std::string replays;
+        std::string archive;
+        BagPolicy policy {BagPolicy::SWAP_SHUFFLE};
+        std::vector<std::pair<unsigned, unsigned>> sizes;
+        std::vector<std::vector<Bric>> bags;
+        for(int i {1}; i < argc; ++i){
+            std::string arg {argv[i]};
+            if(i + 1 >= argc){
+                usage(argv[0]);
+                return 1;
+            }
+            std::string value {argv[++i]};
+            if(arg == "-n"){
+                games = toUnsigned(value);
+            } else if(arg == "-j"){
+                threads = toUnsigned(value);
+            } else if(arg == "-s"){
+                seed = toUnsigned(value);
+            } else if(arg == "-m"){
+                maxSteps = toUnsigned(value);
+            } else if(arg == "-p"){
+                if(value == "swap"){
+                    policy = BagPolicy::SWAP_SHUFFLE;
+                } else if(value == "bag"){
+                    policy = BagPolicy::SEVEN_BAG;
+                } else if(value == "history"){
+                    policy = BagPolicy::HISTORY;
+                } else{
+                    throw std::invalid_argument("politique non valide : " + value);
+                }
+            } else if(arg == "--size"){
+                std::size_t x {value.find('x')};
+                if(x == std::string::npos){
+                    throw std::invalid_argument("taille non valide : " + value);
+                }
+                sizes.emplace_back(toUnsigned(value.substr(0, x)), toUnsigned(value.substr(x + 1)));
+            } else if(arg == "--bag"){
+                bags.push_back(BatchRunner::loadBag(value));
+            } else if(arg == "--bot"){
+                beam = toUnsigned(value);
+            } else if(arg == "--replay"){
+                replays = value;
+            } else if(arg == "--archive"){
+                archive = value;
+            } else{
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        if(sizes.empty()){
+            sizes.emplace_back(10, 20);
+        }
+        if(bags.empty()){
+            bags.emplace_back();
+        }
+        std::vector<GameConfig> configs;
+        for(unsigned u {0}; u < games; ++u){
+            const std::pair<unsigned, unsigned> & size {sizes[u % sizes.size()]};
+            configs.push_back(GameConfig{seed + u, size.first, size.second,
+                                         static_cast<unsigned>((u / sizes.size()) % bags.size()),
+                                         policy, maxSteps, beam,
+                                         replays.empty()? "" : replays + "/" + std::to_string(seed + u) + ".gjtr"});
+        }
+        BatchRunner runner {std::move(bags)};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Replay> recorded;
+        std::vector<GameResult> results {runner.run(configs, threads ? threads : 1,
+                                                    archive.empty()? nullptr : &recorded)};
+        std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+        BatchRunner::report(std::cout, configs, results, elapsed.count());
+        if(!archive.empty()){
+            ReplayArchiveWriter writer {archive};
+            for(const Replay & replay : recorded){
+                writer.add(replay);
+            }
+            writer.close();
+            std::cout << writer.getSize() << " parties archivées dans " << archive << std::endl;
+        }
+    } catch(const std::exception & e){
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
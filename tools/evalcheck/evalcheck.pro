@@ -0,0 +1,32 @@
+#-------------------------------------------------
+#
+# Comparaison des versions scalaire et vectorielle de l'évaluation, sans Qt
+#
+#-------------------------------------------------
+
+TARGET = evalcheck
+TEMPLATE = app
+CONFIG += console C++14
+CONFIG -= qt app_bundle
+
+SOURCES += main.cpp \
+    ../../model/board.cpp \
+    ../../model/boardkernel.cpp \
+    ../../model/bric.cpp \
+    ../../model/bricsBag.cpp \
+    ../../model/movegenerator.cpp \
+    ../../model/color.cpp \
+    ../../model/palette.cpp \
+    ../../model/player.cpp \
+    ../../model/position.cpp \
+    ../../model/random.cpp \
+    ../../model/simulation.cpp \
+    ../../model/zobrist.cpp \
+    ../../model/replay.cpp \
+    ../../model/replayarchive.cpp \
+    ../../model/mappedfile.cpp \
+    ../../bot/evaluator.cpp
+
+HEADERS += ../../model/simulation.h \
+    ../../model/random.h \
+    ../../bot/evaluator.h
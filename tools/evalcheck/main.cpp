@@ -0,0 +1,175 @@
+#include "../../bot/evaluator.h"
+#include "../../model/simulation.h"
+#include "../../model/random.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Méthode affichant l'utilisation du programme.
+ * \param name le nom du programme
+ */
+void usage(const char * name){
+    std::cerr << "Utilisation : " << name << " [options]\n"
+              << "  -n <lots>        nombre de lots par taille de grille (200)\n"
+              << "  -s <graine>      graine des grilles (1)\n";
+}
+
+/*!
+ * \brief Méthode convertissant un argument en entier positif.
+ * \param text l'argument
+ * \return l'entier
+ * \throw std::invalid_argument si l'argument n'est pas un entier positif
+ */
+unsigned toUnsigned(const std::string & text){
+    std::size_t end;
+    unsigned long value {std::stoul(text, &end)};
+    if(end != text.size()){
+        throw std::invalid_argument("nombre non valide : " + text);
+    }
+    return value;
+}
+
+/*!
+ * \brief Méthode remplissant au hasard la grille d'une partie.
+ *
+ * La grille d'un \ref Board ne se modifie qu'à travers une \ref Simulation :
+ * elle est écrite dans un instantané vide de la partie, puis restaurée.
+ * Chaque colonne reçoit une hauteur au hasard, de vide à pleine, puis ses
+ * cases sous cette hauteur sont remplies avec une densité propre à la grille :
+ * les grilles vont des colonnes pleines aux colonnes criblées de trous.
+ *
+ * \param game la partie, initialisée à la taille voulue
+ * \param empty l'instantané de la partie, grille vide
+ * \param random le générateur
+ */
+void fill(Simulation & game, const GameSnapshot & empty, Random & random){
+    GameSnapshot snapshot {empty};
+    snapshot.colors = 2;
+    snapshot.palette[1] = Color(128, 128, 128).getCode();
+    const unsigned width {snapshot.width};
+    const unsigned height {snapshot.height};
+    const unsigned density {random.below(9) + 1};
+    for(unsigned x {0}; x < width; ++x){
+        const unsigned top {random.below(height + 1)};
+        for(unsigned y {height - top}; y < height; ++y){
+            if(y == height - top || random.below(10) < density){
+                snapshot.rows[y] |= Row(1) << x;
+                snapshot.columns[x] |= Column(1) << y;
+                snapshot.cells[y * width + x] = 1;
+            }
+        }
+    }
+    game.restore(snapshot);
+}
+
+/*!
+ * \brief Méthode comparant une caractéristique calculée par les deux versions.
+ *
+ * \param name le nom de la caractéristique
+ * \param scalar les valeurs de la version scalaire
+ * \param vector les valeurs de la version vectorielle
+ * \param size la taille de grille, pour le message
+ * \param reported un écart a-t-il déjà été affiché pour cette taille, mis à jour
+ * \return le nombre de grilles en écart
+ */
+unsigned compare(const char * name, const std::vector<std::uint32_t> & scalar,
+                 const std::vector<std::uint32_t> & vector, const std::string & size, bool & reported){
+    unsigned errors {0};
+    for(std::size_t i {0}; i < scalar.size(); ++i){
+        if(i >= vector.size() || scalar[i] != vector[i]){
+            if(!reported){
+                reported = 1;
+                std::cout << size << " : " << name << " de la grille " << i << " : "
+                          << scalar[i] << " en scalaire, "
+                          << (i < vector.size() ? std::to_string(vector[i]) : "absent") << " en vectoriel\n";
+            }
+            ++errors;
+        }
+    }
+    return errors + (vector.size() > scalar.size());
+}
+
+} // namespace
+
+/*!
+ * \brief Programme vérifiant que \ref Evaluator::computeVector donne exactement
+ * les résultats de \ref Evaluator::computeScalar.
+ *
+ * Pour chaque taille de grille disposant de noyaux spécialisés, de 6x12 à
+ * 12x24, des lots de grilles tirées au hasard sont évalués par les deux
+ * versions. La taille des lots varie pour que la dernière instruction
+ * vectorielle traite aussi des grilles de complément.
+ *
+ * \return 0 si les deux versions concordent, 2 sinon, 1 en cas d'erreur
+ */
+int main(int argc, char * argv[]){
+    try{
+        unsigned batches {200};
+        unsigned seed {1};
+        for(int i {1}; i < argc; ++i){
+            std::string arg {argv[i]};
+            if(i + 1 >= argc){
+                usage(argv[0]);
+                return 1;
+            }
+            std::string value {argv[++i]};
+            if(arg == "-n"){
+                batches = toUnsigned(value);
+            } else if(arg == "-s"){
+                seed = toUnsigned(value);
+            } else{
+                usage(argv[0]);
+                return 1;
+            }
+        }
+#ifdef __SSE2__
+        Random random {seed};
+        unsigned long long boards {0};
+        unsigned errors {0};
+        Features scalar;
+        Features vector;
+        for(unsigned w {Simulation::MINIMUM_WIDTH}; w <= Simulation::MAXIMUM_WIDTH; ++w){
+            for(unsigned h {Simulation::MINIMUM_HEIGHT}; h <= Simulation::MAXIMUM_HEIGHT; ++h){
+                const std::string size {std::to_string(w) + "x" + std::to_string(h)};
+                Simulation game;
+                game.initGame("evalcheck", w, h, Simulation::MAXIMUM_WIN_SCORE, Simulation::MAXIMUM_WIN_LINES,
+                              Simulation::MAXIMUM_WIN_TIME, 0, 0, 0, 0);
+                const GameSnapshot empty {game.capture()};
+                BoardBatch batch {w, h};
+                bool reported {0};
+                for(unsigned b {0}; b < batches; ++b){
+                    batch.clear();
+                    const unsigned count {random.below(4 * BoardBatch::LANES + 1)};
+                    for(unsigned u {0}; u < count; ++u){
+                        fill(game, empty, random);
+                        batch.add(game.getBoard());
+                    }
+                    Evaluator::computeScalar(batch, scalar);
+                    Evaluator::computeVector(batch, vector);
+                    errors += compare("hauteur", scalar.height, vector.height, size, reported)
+                            + compare("trous", scalar.holes, vector.holes, size, reported)
+                            + compare("irrégularité", scalar.bumpiness, vector.bumpiness, size, reported)
+                            + compare("passages", scalar.transitions, vector.transitions, size, reported)
+                            + compare("puits", scalar.wells, vector.wells, size, reported);
+                    boards += count;
+                }
+            }
+        }
+        std::cout << boards << " grilles évaluées, " << errors << " écarts entre les versions scalaire et vectorielle\n";
+        return errors == 0 ? 0 : 2;
+#else
+        (void) batches;
+        (void) seed;
+        std::cout << "version vectorielle non disponible sur ce processeur\n";
+        return 0;
+#endif
+    } catch(const std::exception & e){
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,68 @@
+#include "replayverifier.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace GJ_GW;
+
+namespace{
+
+/*!
+ * \brief Méthode affichant l'utilisation du programme.
+ * \param name le nom du programme
+ */
+void usage(const char * name){
+    std::cerr << "Utilisation : " << name << " [options] <chemin>...\n"
+              << "  -j <threads>     nombre de threads (tous les cœurs)\n"
+              << "  <chemin>         enregistrement (.gjtr), archive (.gjta) ou dossier en contenant\n"
+              << "Un écart est situé entre deux points de contrôle, à " << Replay::CHECK_INTERVAL
+              << " descentes près :\nl'enregistrement ne garde pas l'état du jeu à chaque descente.\n";
+}
+
+/*!
+ * \brief Méthode convertissant un argument en entier positif.
+ * \param text l'argument
+ * \return l'entier
+ * \throw std::invalid_argument si l'argument n'est pas un entier positif
+ */
+unsigned toUnsigned(const std::string & text){
+    std::size_t end;
+    unsigned long value {std::stoul(text, &end)};
+    if(end != text.size()){
+        throw std::invalid_argument("nombre non valide : " + text);
+    }
+    return value;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]){
+    try{
+        unsigned threads {std::thread::hardware_concurrency()};
+        ReplayVerifier verifier;
+        for(int i {1}; i < argc; ++i){
+            std::string arg {argv[i]};
+            if(arg == "-j" && i + 1 < argc){
+                threads = toUnsigned(argv[++i]);
+            } else if(!arg.empty() && arg[0] == '-'){
+                usage(argv[0]);
+                return 1;
+            } else{
+                verifier.add(arg);
+            }
+        }
+        if(verifier.getSize() == 0){
+            usage(argv[0]);
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Verification> verifications {verifier.run(threads ? threads : 1)};
+        std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+        return ReplayVerifier::report(std::cout, verifications, elapsed.count()) == 0 ? 0 : 2;
+    } catch(const std::exception & e){
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
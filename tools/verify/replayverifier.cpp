@@ -0,0 +1,173 @@
+#include "replayverifier.h"
+#include "../../model/workstealingpool.h"
+#include "../../model/simulation.h"
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using namespace GJ_GW;
+
+constexpr std::size_t ReplayVerifier::ALONE;
+
+namespace{
+
+/*!
+ * \brief Méthode vérifiant si un nom de fichier se termine par une extension.
+ *
+ * \param name le nom du fichier
+ * \param extension l'extension, point compris
+ * \return true si le nom se termine par l'extension, false sinon
+ */
+bool endsWith(const std::string & name, const std::string & extension){
+    return name.size() > extension.size()
+            && name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/*!
+ * \brief Méthode décrivant la fin d'une partie.
+ * \param result la fin de la partie
+ * \return le score, les lignes et la clé de la grille
+ */
+std::string describe(const ReplayResult & result){
+    std::ostringstream out;
+    out << "score " << result.score << ", " << result.lines << " lignes, grille "
+        << std::hex << std::setw(16) << std::setfill('0') << result.hash;
+    return out.str();
+}
+
+} // namespace
+
+void ReplayVerifier::add(const std::string & path){
+    DIR * directory {opendir(path.c_str())};
+    if(directory){
+        std::vector<std::string> names;
+        while(dirent * entry {readdir(directory)}){
+            std::string name {entry->d_name};
+            if(endsWith(name, ".gjtr") || endsWith(name, ".gjta")){
+                names.push_back(path + "/" + name);
+            }
+        }
+        closedir(directory);
+        std::sort(names.begin(), names.end());
+        for(const std::string & name : names){
+            add(name);
+        }
+        return;
+    }
+    std::ifstream file {path, std::ios::binary};
+    char magic[4] {};
+    if(!file.read(magic, sizeof(magic))){
+        throw std::invalid_argument("impossible de lire " + path);
+    }
+    if(std::string(magic, sizeof(magic)) == "GJTA"){
+        archives_.emplace_back(new ReplayArchive(path));
+        archiveNames_.push_back(path);
+        for(std::size_t u {0}; u < archives_.back()->getSize(); ++u){
+            games_.emplace_back(archives_.size() - 1, u);
+        }
+    } else{
+        files_.push_back(path);
+        games_.emplace_back(files_.size() - 1, ALONE);
+    }
+}
+
+std::vector<Verification> ReplayVerifier::run(unsigned threads) const{
+    std::vector<Verification> verifications(games_.size());
+    WorkStealingPool pool {threads};
+    for(std::size_t i {0}; i < games_.size(); ++i){
+        pool.submit([this, &verifications, i]{
+            verifications[i] = verify(i);
+        });
+    }
+    pool.wait();
+    return verifications;
+}
+
+Verification ReplayVerifier::verify(const Replay & replay){
+    Verification verification {};
+    Simulation game;
+    replay.start(game);
+    ReplayPlayer player {replay};
+    compare(game, player, replay.getResult(), verification);
+    return verification;
+}
+
+Verification ReplayVerifier::verify(std::size_t game) const{
+    const std::pair<std::size_t, std::size_t> & source {games_[game]};
+    Verification verification {};
+    try{
+        if(source.second == ALONE){
+            const std::string & path {files_[source.first]};
+            std::ifstream file {path, std::ios::binary};
+            if(!file){
+                throw std::invalid_argument("impossible de lire " + path);
+            }
+            verification = verify(Replay::load(file));
+            verification.name = path;
+        } else{
+            const ReplayArchive & archive {*archives_[source.first]};
+            const ArchiveEntry & entry {archive.getEntry(source.second)};
+            verification.name = archiveNames_[source.first] + "#" + std::to_string(source.second);
+            Simulation simulation;
+            ReplayPlayer player {archive.seek(source.second, 0, simulation)};
+            compare(simulation, player,
+                    ReplayResult{entry.hash, entry.score, entry.lines, static_cast<GameState>(entry.gameState)},
+                    verification);
+        }
+    } catch(const std::exception & e){
+        verification.error = e.what();
+        if(verification.name.empty()){
+            verification.name = files_[source.first];
+        }
+    }
+    return verification;
+}
+
+void ReplayVerifier::compare(Simulation & game, ReplayPlayer & player, const ReplayResult & expected,
+                             Verification & verification){
+    player.run(game);
+    verification.expected = expected;
+    verification.actual = ReplayResult{game.getBoard().getHash(), game.getPlayer().getScore(),
+                                       game.getPlayer().getNbLines(), game.getGameState()};
+    verification.ticks = player.getTick();
+    verification.lastCheck = player.getLastCheck();
+    verification.divergence = player.getDivergence();
+    verification.diverged = player.hasDiverged();
+    verification.identical = !verification.diverged
+            && verification.actual.hash == expected.hash && verification.actual.score == expected.score
+            && verification.actual.lines == expected.lines && verification.actual.gameState == expected.gameState;
+}
+
+std::size_t ReplayVerifier::report(std::ostream & out, const std::vector<Verification> & verifications,
+                                   double seconds){
+    std::size_t errors {0};
+    std::size_t divergences {0};
+    unsigned long long ticks {0};
+    for(const Verification & verification : verifications){
+        ticks += verification.ticks;
+        if(!verification.error.empty()){
+            ++errors;
+            out << verification.name << " : illisible : " << verification.error << "\n";
+        } else if(!verification.identical){
+            ++divergences;
+            out << verification.name << " : écart ";
+            if(verification.diverged){
+                out << "entre les descentes " << verification.lastCheck << " et " << verification.divergence;
+            } else{
+                out << "entre la descente " << verification.lastCheck << " et la fin (" << verification.ticks << ")";
+            }
+            out << "\n    attendu : " << describe(verification.expected)
+                << "\n    obtenu  : " << describe(verification.actual) << "\n";
+        }
+    }
+    out << std::fixed << std::setprecision(1)
+        << verifications.size() << " parties vérifiées en " << seconds << " s : "
+        << verifications.size() / seconds << " parties/s, "
+        << ticks / seconds << " descentes/s\n"
+        << verifications.size() - errors - divergences << " identiques, "
+        << divergences << " en écart, " << errors << " illisibles\n";
+    return errors + divergences;
+}
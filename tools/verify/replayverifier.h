@@ -0,0 +1,158 @@
+#ifndef REPLAYVERIFIER_H
+#define REPLAYVERIFIER_H
+
+#include "../../model/replay.h"
+#include "../../model/replayarchive.h"
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+
+/*!
+ * \brief Structure décrivant la vérification d'une partie enregistrée.
+ */
+struct Verification{
+    std::string name;
+    /*!< Le fichier de l'enregistrement, suivi du numéro de la partie pour une archive. */
+
+    std::string error;
+    /*!< La raison pour laquelle la partie n'a pu être rejouée, vide si elle l'a été. */
+
+    ReplayResult expected;
+    /*!< La fin de la partie enregistrée. */
+
+    ReplayResult actual;
+    /*!< La fin de la partie rejouée. */
+
+    std::uint64_t ticks;
+    /*!< Le nombre de descentes automatiques rejouées. */
+
+    std::uint64_t lastCheck;
+    /*!< La descente du dernier point de contrôle identique avant tout écart. */
+
+    std::uint64_t divergence;
+    /*!< La descente du premier point de contrôle en écart, valide si \ref diverged est vrai. */
+
+    bool diverged;
+    /*!< Un point de contrôle rejoué diffère-t-il de l'enregistrement. */
+
+    bool identical;
+    /*!< La partie rejouée est-elle identique à l'enregistrement. */
+};
+
+/*!
+ * \brief Classe rejouant des parties enregistrées sur tous les cœurs pour
+ * vérifier que la simulation est restée déterministe.
+ *
+ * Chaque partie est rejouée dans une \ref Simulation sans Qt ; sa grille
+ * (par sa clé de \ref Zobrist), son score et ses lignes finaux sont comparés
+ * à ceux de l'enregistrement. Les points de contrôle du \ref Replay situent
+ * le premier écart à \ref Replay::CHECK_INTERVAL descentes près, pas à la
+ * descente exacte : l'enregistrement ne contient que leur empreinte, et les
+ * images clés d'une archive ne sont elles-mêmes qu'une partie rejouée.
+ *
+ * Toute modification de la grille, des briques ou du sac qui change le
+ * déroulement d'une partie apparaît ainsi sur un corpus de parties réelles.
+ */
+class ReplayVerifier{
+    std::vector<std::string> files_;
+    /*!< Les fichiers d'enregistrement isolés. */
+
+    std::vector<std::unique_ptr<ReplayArchive>> archives_;
+    /*!< Les archives, projetées en mémoire. */
+
+    std::vector<std::string> archiveNames_;
+    /*!< Les chemins des archives. */
+
+    std::vector<std::pair<std::size_t, std::size_t>> games_;
+    /*!< Les parties à vérifier : l'indice de l'archive et le numéro de la partie,
+     * ou l'indice du fichier isolé et \ref ALONE. */
+
+    constexpr static std::size_t ALONE {~std::size_t(0)};
+    /*!< Le numéro de partie désignant un fichier isolé. */
+
+public:
+    /*!
+     * \brief Méthode ajoutant des parties à vérifier.
+     *
+     * Une archive ajoute toutes ses parties ; un dossier ajoute les
+     * enregistrements (.gjtr) et les archives (.gjta) qu'il contient.
+     *
+     * \param path le chemin d'un enregistrement, d'une archive ou d'un dossier
+     * \throw std::invalid_argument si le fichier ne peut être lu ou si
+     * l'archive n'est pas valide
+     */
+    void add(const std::string & path);
+
+    /*!
+     * \brief Accesseur en lecture du nombre de parties à vérifier.
+     * \return le nombre de parties
+     */
+    inline std::size_t getSize() const;
+
+    /*!
+     * \brief Méthode vérifiant toutes les parties en parallèle.
+     *
+     * Les parties sont réparties sur un \ref WorkStealingPool. Un
+     * enregistrement illisible est signalé dans sa \ref Verification sans
+     * interrompre les autres.
+     *
+     * \param threads le nombre de threads
+     * \return les vérifications, dans l'ordre des parties
+     */
+    std::vector<Verification> run(unsigned threads) const;
+
+    /*!
+     * \brief Méthode rejouant une partie et la comparant à son enregistrement.
+     *
+     * \param replay l'enregistrement, terminé
+     * \return la vérification
+     */
+    static Verification verify(const Replay & replay);
+
+    /*!
+     * \brief Méthode écrivant les écarts et le bilan d'un lot de vérifications.
+     *
+     * \param out le flux de sortie
+     * \param verifications les vérifications
+     * \param seconds la durée du lot en secondes
+     * \return le nombre de parties qui ne sont pas identiques à leur enregistrement
+     */
+    static std::size_t report(std::ostream & out, const std::vector<Verification> & verifications,
+                              double seconds);
+
+private:
+    /*!
+     * \brief Méthode vérifiant une des parties ajoutées.
+     *
+     * \param game l'indice de la partie dans \ref games_
+     * \return la vérification
+     */
+    Verification verify(std::size_t game) const;
+
+    /*!
+     * \brief Méthode rejouant la suite d'une partie et la comparant à son enregistrement.
+     *
+     * \param game la partie, préparée pour être rejouée
+     * \param player le lecteur des actions de la partie
+     * \param expected la fin de la partie enregistrée
+     * \param verification la vérification à compléter
+     */
+    static void compare(Simulation & game, ReplayPlayer & player, const ReplayResult & expected,
+                        Verification & verification);
+};
+
+//méthodes inline
+std::size_t ReplayVerifier::getSize() const{
+    return games_.size();
+}
+
+} // namespace GJ_GW
+
+#endif // REPLAYVERIFIER_H
@@ -0,0 +1,36 @@
+#-------------------------------------------------
+#
+# Vérificateur du déterminisme des parties enregistrées, sans Qt
+#
+#-------------------------------------------------
+
+TARGET = verify
+TEMPLATE = app
+CONFIG += console C++14 thread
+CONFIG -= qt app_bundle
+
+SOURCES += main.cpp \
+    replayverifier.cpp \
+    ../../model/board.cpp \
+    ../../model/boardkernel.cpp \
+    ../../model/bric.cpp \
+    ../../model/bricsBag.cpp \
+    ../../model/movegenerator.cpp \
+    ../../model/color.cpp \
+    ../../model/palette.cpp \
+    ../../model/player.cpp \
+    ../../model/position.cpp \
+    ../../model/random.cpp \
+    ../../model/simulation.cpp \
+    ../../model/zobrist.cpp \
+    ../../model/replay.cpp \
+    ../../model/replayarchive.cpp \
+    ../../model/mappedfile.cpp \
+    ../../model/workstealingpool.cpp
+
+HEADERS += replayverifier.h \
+    ../../model/simulation.h \
+    ../../model/replay.h \
+    ../../model/replayarchive.h \
+    ../../model/mappedfile.h \
+    ../../model/workstealingpool.h
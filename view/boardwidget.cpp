@@ -0,0 +1,77 @@
+#include "boardwidget.h"
+#include "../model/board.h"
+#include <QPaintEvent>
+#include <QPainter>
+#include <algorithm>
+
+using namespace GJ_GW;
+
+BoardWidget::BoardWidget(QWidget * parent): QWidget(parent), board_{nullptr}{
+}
+
+void BoardWidget::setBoard(const Board & board){
+    board_ = &board;
+    setFixedSize(board.getWidth() * (CELL + SPACING) - SPACING,
+                 board.getHeight() * (CELL + SPACING) - SPACING);
+    update();
+}
+
+void BoardWidget::refresh(){
+    if(!board_){
+        return;
+    }
+    for(Column rows {board_->getDirtyRows()}; rows != 0; rows &= rows - 1){
+        unsigned y = __builtin_ctz(rows);
+        Row cells {board_->getDirtyRow(y)};
+        if(cells != 0){
+            update(cellRect(__builtin_ctz(cells), y).united(cellRect(31 - __builtin_clz(cells), y)));
+        }
+    }
+}
+
+void BoardWidget::paintEvent(QPaintEvent * event){
+    if(!board_){
+        return;
+    }
+    QPainter painter(this);
+    const QRect area {event->rect()};
+    const unsigned left = std::max(area.left(), 0) / (CELL + SPACING);
+    const unsigned top = std::max(area.top(), 0) / (CELL + SPACING);
+    const unsigned right = std::min<unsigned>(area.right() / (CELL + SPACING), board_->getWidth() - 1);
+    const unsigned bottom = std::min<unsigned>(area.bottom() / (CELL + SPACING), board_->getHeight() - 1);
+    for(unsigned y {top}; y <= bottom; ++y){
+        for(unsigned x {left}; x <= right; ++x){
+            const QRect rect {cellRect(x, y)};
+            if(event->region().intersects(rect)){
+                painter.drawPixmap(rect.topLeft(), cell(board_->getColor(x, y)));
+            }
+        }
+    }
+}
+
+const QPixmap & BoardWidget::cell(const Color & color){
+    auto it = cells_.find(color.getCode());
+    if(it != cells_.end()){
+        return *it;
+    }
+    QColor fill(color.getRed(), color.getGreen(), color.getBlue());
+    QColor border((color.getRed() <= 30)? 0 : color.getRed()-30, color.getGreen(), color.getBlue());
+    QPixmap pixmap(CELL, CELL);
+    QPainter painter(&pixmap);
+    painter.setPen(Qt::NoPen);
+    const QPoint light[] {QPoint(0, 0), QPoint(CELL, 0), QPoint(CELL - BORDER, BORDER),
+                          QPoint(BORDER, BORDER), QPoint(BORDER, CELL - BORDER), QPoint(0, CELL)};
+    const QPoint shadow[] {QPoint(CELL, CELL), QPoint(0, CELL), QPoint(BORDER, CELL - BORDER),
+                           QPoint(CELL - BORDER, CELL - BORDER), QPoint(CELL - BORDER, BORDER), QPoint(CELL, 0)};
+    painter.setBrush(border.lighter(130));
+    painter.drawPolygon(light, 6);          // relief "outset" : bords haut et gauche éclairés
+    painter.setBrush(border.darker(130));
+    painter.drawPolygon(shadow, 6);         // bords bas et droit dans l'ombre
+    painter.fillRect(BORDER, BORDER, CELL - 2*BORDER, CELL - 2*BORDER, fill);
+    painter.end();
+    return *cells_.insert(color.getCode(), pixmap);
+}
+
+QRect BoardWidget::cellRect(unsigned x, unsigned y) const{
+    return QRect(x * (CELL + SPACING), y * (CELL + SPACING), CELL, CELL);
+}
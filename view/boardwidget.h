@@ -0,0 +1,93 @@
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QWidget>
+#include <cstdint>
+
+/*!
+ * \brief Espace de nom de Guillaume Jouret & Guillaume Walravens.
+ */
+namespace GJ_GW{
+class Board;
+class Color;
+}
+
+/*!
+ * \brief Classe représentant l'affichage d'un \ref Board, dessiné case par case.
+ *
+ * Chaque case est la copie d'une image préparée une seule fois par couleur :
+ * aucun widget ni feuille de style n'est créé pendant la partie. Seules les
+ * cases modifiées depuis le dernier rafraîchissement sont redessinées.
+ */
+class BoardWidget : public QWidget{
+    Q_OBJECT
+
+public:
+    constexpr static int CELL {30};
+    /*!< Le côté d'une case, en pixels. */
+
+    constexpr static int SPACING {3};
+    /*!< L'espace entre deux cases, en pixels. */
+
+    constexpr static int BORDER {5};
+    /*!< L'épaisseur du relief d'une case, en pixels. */
+
+private:
+    const GJ_GW::Board * board_;
+    /*!< La grille affichée, nullptr tant qu'aucune n'a été donnée. */
+
+    QHash<std::uint32_t, QPixmap> cells_;
+    /*!< Les images des cases, par code de couleur. */
+
+public:
+    /*!
+     * \brief Constructeur de \ref BoardWidget.
+     * \param parent le widget parent
+     */
+    explicit BoardWidget(QWidget * parent = 0);
+
+    /*!
+     * \brief Méthode changeant la grille affichée et la redessinant entièrement.
+     *
+     * Le widget prend la taille de la grille.
+     *
+     * \param board la grille, qui doit rester en vie tant qu'elle est affichée
+     */
+    void setBoard(const GJ_GW::Board & board);
+
+    /*!
+     * \brief Méthode demandant de redessiner les cases modifiées de la grille.
+     *
+     * Elle est appelée pendant la notification de la partie, avant que
+     * \ref Board::getDirtyRows ne soit remis à zéro ; chaque ligne modifiée
+     * ne redessine que l'intervalle de ses cases modifiées.
+     */
+    void refresh();
+
+protected:
+    /*!
+     * \brief Méthode dessinant les cases de la zone à redessiner.
+     * \param event la zone à redessiner
+     */
+    void paintEvent(QPaintEvent * event) override;
+
+private:
+    /*!
+     * \brief Méthode donnant l'image d'une case d'une couleur, préparée à sa première demande.
+     * \param color la couleur de la case
+     * \return l'image de la case
+     */
+    const QPixmap & cell(const GJ_GW::Color & color);
+
+    /*!
+     * \brief Méthode donnant le rectangle occupé par une case.
+     * \param x l'abscisse de la case
+     * \param y l'ordonnée de la case
+     * \return le rectangle, en pixels
+     */
+    QRect cellRect(unsigned x, unsigned y) const;
+};
+
+#endif // BOARDWIDGET_H
@@ -1,6 +1,7 @@
 #include "configdialog.h"
 #include "ui_configdialog.h"
 #include "setbricsdialog.h"
+#include "../model/bricsBag.h"
 #include <QErrorMessage>
 
 using namespace GJ_GW;
@@ -135,7 +136,10 @@ void ConfigDialog::setBrics(){
             }
         }
         try{
-            brics_.push_back(Bric(bric, Color(color)));
+            brics_.push_back(Bric(bric, Color(color.at(0), color.at(1), color.at(2))));
+            if(brics_.size() == BricsBag::MAXIMUM_BRICS){
+                ui->bricSetter->setDisabled(true);
+            }
         } catch(const std::invalid_argument & e){
             QErrorMessage * except = new QErrorMessage(this);
             except->showMessage(e.what());
@@ -152,7 +152,8 @@ private slots:
     /*!
      * \brief Méthode permettant de créer une \ref Bric personnalisée.
      *
-     * Elle lance une exception si la brique est invalide
+     * Elle lance une exception si la brique est invalide. Le bouton est désactivé
+     * une fois \ref BricsBag::MAXIMUM_BRICS briques créées.
      */
     void setBrics();
 
@@ -2,6 +2,7 @@
 #include "ui_mwtetris.h"
 #include "configdialog.h"
 #include "confirmlaunchdialog.h"
+#include "boardwidget.h"
 #include "../model/gamestate.h"
 #include "../model/direction.h"
 #include "../network/multitetris.h"
@@ -14,12 +15,20 @@
 #include <QProgressDialog>
 #include <iostream>
 #include <QtConcurrent>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QStandardPaths>
+#include <fstream>
 
 using namespace GJ_GW;
 
 MWTetris::MWTetris(QWidget *parent) : QMainWindow(parent), ui(new Ui::MWTetris){
     ui->setupUi(this);
     connect(ui->action_Nouveau, &QAction::triggered, this, &MWTetris::createGame);
+    connect(ui->action_Automatique, &QAction::toggled, this, &MWTetris::setAutomatic);
+    connect(ui->action_Enregistrer, &QAction::toggled, this, &MWTetris::setRecording);
+    connect(ui->action_Revoir, &QAction::triggered, this, &MWTetris::showReplay);
     connect(ui->action_Quitter, &QAction::triggered, this, &QCoreApplication::quit);
     connect(ui->btnDown, &QPushButton::clicked, this, &MWTetris::drop);
     connect(ui->btnLeft, &QPushButton::clicked, this, &MWTetris::left);
@@ -35,21 +44,38 @@ MWTetris::MWTetris(QWidget *parent) : QMainWindow(parent), ui(new Ui::MWTetris){
     lbEnd_ = 0;
     lbEnd_ = new QLabel(this);
     lbEnd_->hide();
+    boardView_ = new BoardWidget(this);
+    ui->boardGrid->addWidget(boardView_, 0, 0);
     time_ = new QTimer(this);
     time_->setInterval(1000);
     connect(time_, SIGNAL(timeout()), this, SLOT(showTime()));
+    bot_ = new BotPlayer(&game_, 1, this);
+    player_ = nullptr;
+    replayTimer_ = new QTimer(this);
+    connect(replayTimer_, SIGNAL(timeout()), this, SLOT(replayTick()));
     game_.initServer();
     game_.addObserver(this);
+    dropped_ = 0;
+    frame_ = new QTimer(this);
+    frame_->setInterval(16);
+    connect(frame_, SIGNAL(timeout()), this, SLOT(showEvents()));
+    game_.addEventObserver(&events_, GameEvent::mask(GameEventKind::SCORE_CHANGED)
+                           | GameEvent::mask(GameEventKind::PIECE_SPAWNED));
     update(&game_);
     showHostInfo();
 }
 
 MWTetris::~MWTetris() noexcept{
+    stopReplay();
+    delete bot_;
+    game_.setRecording(nullptr);
     game_.removeObserver(this);
+    game_.removeEventObserver(&events_);
     delete ui;
 }
 
 void MWTetris::createGame(){
+    stopReplay();
     if(game_.getMode() == GameMode::SOLO){
         game_.initServer();
         showHostInfo();
@@ -110,6 +136,9 @@ void MWTetris::createGame(){
         } catch(const std::invalid_argument & e){
             QErrorMessage * except = new QErrorMessage(this);
             except->showMessage(e.what());
+        } catch(const std::length_error & e){
+            QErrorMessage * except = new QErrorMessage(this);
+            except->showMessage(e.what());
         }
     }
 }
@@ -154,27 +183,11 @@ void MWTetris::showHostInfo(){
 
 void MWTetris::generateBoard(bool end){
     if(end){
-        ui->boardGrid->addWidget(lbEnd_, game_.getBoard().getHeight()/2, 0, 1, game_.getBoard().getWidth(), Qt::AlignCenter);
+        ui->boardGrid->addWidget(lbEnd_, 0, 0, Qt::AlignCenter);
+        lbEnd_->raise();
         lbEnd_->show();
     } else{
-        std::map<Position, Color> theGrid {game_.getBoard().getGrid()};
-        unsigned width {((30+3)*game_.getBoard().getWidth())-3+40};     //(30px + 3px de spacing) * nombre de cases en largeur - 1 spacing + 2*20px de margin
-        unsigned height {((30+3)*game_.getBoard().getHeight())-3+40};   //(30px + 3px de spacing) * nombre de cases en hauteur - 1 spacing + 2*20px de margin
-        ui->boardGrid->setSpacing(3);
-        ui->boardGrid->setGeometry(QRect(0,0,width,height));
-        for(auto it = theGrid.begin(); it != theGrid.end(); ++it){
-            QLabel *lb = new QLabel(this);
-            QColor color(it->second.getCode().at(0),
-                         it->second.getCode().at(1),
-                         it->second.getCode().at(2));
-            QColor border((it->second.getCode().at(0) <= 30)? 0 : it->second.getCode().at(0)-30,
-                          it->second.getCode().at(1),
-                          it->second.getCode().at(2));
-            setStyleSheet(lb, color.name(), border.name());
-            lb->setText(color.name());
-            lb->setFixedSize(30,30);
-            ui->boardGrid->addWidget(lb, ((it->first.getY() < game_.getBoard().getHeight()/2)? it->first.getY() : it->first.getY()+1), it->first.getX(), 1, 1);
-        }
+        boardView_->setBoard(game_.getBoard());
     }
 }
 
@@ -188,27 +201,6 @@ void MWTetris::setStyleSheet(QLabel *lb, QString color, QString border){
     lb->setStyleSheet(styleSheet.arg(color, border));
 }
 
-void MWTetris::refreshBoard(){
-    std::map<Position, Color> theGrid {game_.getBoard().getGrid()};
-    for(auto it = theGrid.begin(); it != theGrid.end(); ++it){
-        QLabel *oldLb = qobject_cast<QLabel*>(ui->boardGrid->itemAtPosition(((it->first.getY() < game_.getBoard().getHeight()/2)? it->first.getY() : it->first.getY()+1), it->first.getX())->widget());
-        QColor color(it->second.getCode().at(0),
-                     it->second.getCode().at(1),
-                     it->second.getCode().at(2));
-        if(oldLb->text().compare(color.name())){
-            QColor border((it->second.getCode().at(0) <= 30)? 0 : it->second.getCode().at(0)-30,
-                          it->second.getCode().at(1),
-                          it->second.getCode().at(2));
-            QLabel *newLb = new QLabel(this);
-            setStyleSheet(newLb, color.name(), border.name());
-            newLb->setText(color.name());
-            newLb->setFixedSize(30,30);
-            ui->boardGrid->replaceWidget(oldLb,newLb);
-            delete oldLb;
-        }
-    }
-}
-
 void MWTetris::eraseBoard(QGridLayout * board){
     QLayoutItem *child;
     while((child = board->takeAt(0)) != 0){
@@ -226,12 +218,12 @@ void MWTetris::showNextBric(){
             lb->setFixedSize(20,20);
             Position temp = Position(u, v);
             if(theBric.contains(temp)){
-                QColor color(theBric.getColor().getCode().at(0),
-                             theBric.getColor().getCode().at(1),
-                             theBric.getColor().getCode().at(2));
-                QColor border((theBric.getColor().getCode().at(0) <= 30)? 0 : theBric.getColor().getCode().at(0)-30,
-                              theBric.getColor().getCode().at(1),
-                              theBric.getColor().getCode().at(2));
+                QColor color(theBric.getColor().getRed(),
+                             theBric.getColor().getGreen(),
+                             theBric.getColor().getBlue());
+                QColor border((theBric.getColor().getRed() <= 30)? 0 : theBric.getColor().getRed()-30,
+                              theBric.getColor().getGreen(),
+                              theBric.getColor().getBlue());
                 setStyleSheet(lb, color.name(), border.name());
             } else{
                 lb->setHidden(true);
@@ -242,42 +234,76 @@ void MWTetris::showNextBric(){
 }
 
 void MWTetris::left(){
-    game_.checkMove(Direction::LEFT);
+    game_.step(Input::LEFT);
 }
 
 void MWTetris::right(){
-    game_.checkMove(Direction::RIGHT);
+    game_.step(Input::RIGHT);
 }
 
 void MWTetris::rotate(){
-    game_.checkRotate();
+    game_.step(Input::ROTATE);
 }
 
 void MWTetris::drop(){
-    game_.drop();
+    game_.step(Input::DROP);
+}
+
+void MWTetris::showEvents(){
+    GameEvent score {};
+    bool scored {0};
+    bool spawned {0};
+    events_.drain([&](const GameEvent & event){
+        if(event.kind == GameEventKind::SCORE_CHANGED){
+            score = event;
+            scored = 1;
+        } else if(event.kind == GameEventKind::PIECE_SPAWNED){
+            spawned = 1;
+        }
+    });
+    if(events_.getDropped() != dropped_){
+        dropped_ = events_.getDropped();
+        score.score = game_.getPlayer().getScore();
+        score.lines = game_.getPlayer().getNbLines();
+        scored = 1;
+        spawned = 1;
+    }
+    if(scored){
+        showScore(score.score, score.lines);
+    }
+    if(spawned){
+        eraseBoard(ui->boardNext);
+        showNextBric();
+    }
+}
+
+void MWTetris::showScore(unsigned score, unsigned lines){
+    ui->lbPlayerScore->setText(QString::number(score) + ((game_.hasWinByScore())? "/" + QString::number(game_.getWinScore()) : ""));
+    ui->lbPlayerLines->setText(QString::number(lines) + ((game_.hasWinByLines())? "/" + QString::number(game_.getWinLines()) : ""));
 }
 
 void MWTetris::update(Subject *){
-    ui->lbPlayerScore->setText(QString::number(game_.getPlayer().getScore()) + ((game_.hasWinByScore())? "/" + QString::number(game_.getWinScore()) : ""));
-    ui->lbPlayerLines->setText(QString::number(game_.getPlayer().getNbLines()) + ((game_.hasWinByLines())? "/" + QString::number(game_.getWinLines()) : ""));
     int ret;
     switch (game_.getGameState()){
     case GameState::NONE:
+        showScore(game_.getPlayer().getScore(), game_.getPlayer().getNbLines());
         if(QString::fromStdString(game_.getPlayer().getName()) != ui->lbPlayerName->text()){
             ui->lbPlayerName->setText(QString::fromStdString(game_.getPlayer().getName()));
         }
-        eraseBoard(ui->boardGrid);
+        lbEnd_->hide();
+        followEvents(false);
         generateBoard();
         break;
     case GameState::INITIALIZED:
-        lbEnd_ = nullptr;
+        showScore(game_.getPlayer().getScore(), game_.getPlayer().getNbLines());
+        delete lbEnd_;
         lbEnd_ = new QLabel(this);
         lbEnd_->hide();
+        followEvents(false);
 
         if(QString::fromStdString(game_.getPlayer().getName()) != ui->lbPlayerName->text()){
             ui->lbPlayerName->setText(QString::fromStdString(game_.getPlayer().getName()));
         }
-        eraseBoard(ui->boardGrid);
         generateBoard();
         ret = QDialog::Accepted;
         if(game_.getMode() != GameMode::SOLO){
@@ -292,17 +318,15 @@ void MWTetris::update(Subject *){
             }
         }
         if(game_.getMode()==GameMode::CLIENT) game_.addObserver(this);
-        if(ret == QDialog::Accepted) launchGame();
+        if(ret == QDialog::Accepted && !player_) launchGame();
         break;
     case GameState::NEW_BRIC:
-        eraseBoard(ui->boardNext);
-        showNextBric();
-        break;
     case GameState::ON:
         if(QString::number(game_.getLevel()) != ui->lbLevelGame->text()){
             ui->lbLevelGame->setText(QString::number(game_.getLevel()));
         }
-        refreshBoard();
+        boardView_->refresh();
+        followEvents(!game_.isPaused() || player_);
         if(game_.isPaused()){
             ui->btnUp->setDisabled(true);
             ui->btnDown->setDisabled(true);
@@ -349,7 +373,9 @@ void MWTetris::update(Subject *){
 }
 
 void MWTetris::endGame(){
+    boardView_->refresh();
     time_->stop();
+    followEvents(false);
     ui->btnPause->setDisabled(true);
     ui->btnUp->setDisabled(true);
     ui->btnDown->setDisabled(true);
@@ -365,6 +391,42 @@ void MWTetris::endGame(){
     lbEnd_->setAlignment(Qt::AlignCenter);
     lbEnd_->adjustSize();
     generateBoard(true);
+    if(ui->action_Enregistrer->isChecked() && !player_ && recording_.isFinished()){
+        saveReplay();
+    }
+}
+
+void MWTetris::saveReplay(){
+    QDir dir {QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)};
+    if(!dir.mkpath("replays")){
+        QErrorMessage * except = new QErrorMessage(this);
+        except->showMessage("impossible de créer le dossier " + dir.filePath("replays"));
+        return;
+    }
+    QString path {dir.filePath("replays/" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".gjtr")};
+    std::ofstream out {path.toStdString(), std::ios::binary};
+    recording_.save(out);
+    if(!out){
+        QErrorMessage * except = new QErrorMessage(this);
+        except->showMessage("impossible d'écrire la partie dans " + path);
+    }
+}
+
+void MWTetris::stopReplay(){
+    replayTimer_->stop();
+    delete player_;
+    player_ = nullptr;
+}
+
+void MWTetris::followEvents(bool running){
+    if(running){
+        if(!frame_->isActive()){
+            frame_->start();
+        }
+    } else if(frame_->isActive()){
+        frame_->stop();
+        showEvents();
+    }
 }
 
 void MWTetris::setPaused(){
@@ -393,4 +455,58 @@ void MWTetris::showTime(){
         lb.append("0");
     lb.append(QString::number(sec));
     ui->lbTime->setText(lb);
+    EventLatency latency {events_.getLatency()};
+    ui->lbTime->setToolTip(QString("Délai des événements : médiane %1 µs, 99e centile %2 µs, max %3 µs (%4 lus, %5 perdus)")
+                           .arg(latency.median / 1000.0, 0, 'f', 1)
+                           .arg(latency.p99 / 1000.0, 0, 'f', 1)
+                           .arg(latency.max / 1000.0, 0, 'f', 1)
+                           .arg(latency.count)
+                           .arg(events_.getDropped()));
+}
+
+void MWTetris::setRecording(bool checked){
+    game_.setRecording(checked? &recording_ : nullptr);
+}
+
+void MWTetris::showReplay(){
+    QDir dir {QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)};
+    QString path {QFileDialog::getOpenFileName(this, "Revoir une partie", dir.filePath("replays"),
+                                               "Parties enregistrées (*.gjtr)")};
+    if(path.isEmpty()){
+        return;
+    }
+    try{
+        std::ifstream in {path.toStdString(), std::ios::binary};
+        Replay replay {Replay::load(in)};
+        stopReplay();
+        ui->action_Automatique->setChecked(false);
+        ui->action_Enregistrer->setChecked(false);
+        game_.setMode(GameMode::SOLO);
+        showHostInfo();
+        replay_ = replay;
+        player_ = new ReplayPlayer(replay_);
+        replay_.start(game_);
+        game_.pause();
+        replayTimer_->start(game_.getInterval());
+    } catch(const std::invalid_argument & e){
+        stopReplay();
+        QErrorMessage * except = new QErrorMessage(this);
+        except->showMessage(e.what());
+    }
+}
+
+void MWTetris::replayTick(){
+    if(player_->tick(game_)){
+        replayTimer_->setInterval(game_.getInterval());
+    } else{
+        stopReplay();
+    }
+}
+
+void MWTetris::setAutomatic(bool checked){
+    if(checked){
+        bot_->start();
+    } else{
+        bot_->stop();
+    }
 }
@@ -2,7 +2,10 @@
 #define MWTETRIS_H
 
 #include "../observer/observer.h"
+#include "../model/eventqueue.h"
 #include "../network/multitetris.h"
+#include "../bot/botplayer.h"
+#include "../model/replay.h"
 #include <QMainWindow>
 #include <QElapsedTimer>
 #include <QGridLayout>
@@ -16,6 +19,8 @@ class MWTetris;
 class QTimer;
 }
 
+class BoardWidget;
+
 /*!
  * \brief Classe représentant la fenêtre principale du \ref Tetris.
  */
@@ -24,7 +29,16 @@ class MWTetris : public QMainWindow, public GJ_GW::Observer{
     Ui::MWTetris *ui;
     GJ_GW::MultiTetris game_;
     QLabel * lbEnd_;
+    BoardWidget * boardView_;
     QTimer * time_;
+    GJ_GW::BotPlayer * bot_;
+    GJ_GW::Replay recording_;
+    GJ_GW::Replay replay_;
+    GJ_GW::ReplayPlayer * player_;
+    QTimer * replayTimer_;
+    GJ_GW::EventQueue events_;
+    QTimer * frame_;
+    std::uint64_t dropped_;
 
 public:
     /*!
@@ -48,8 +62,7 @@ private:
     void showHostInfo();
 
     /*!
-     * \brief Méthode générant et affichant un \ref Board correspondant
-     * à celle de \ref Tetris.
+     * \brief Méthode affichant entièrement le \ref Board de \ref Tetris dans le \ref BoardWidget.
      *
      * Elle affiche le message de fin de partie au sein de la grille.
      *
@@ -57,10 +70,16 @@ private:
      */
     void generateBoard(bool end = 0);
 
-    void refreshBoard();
-
     void setStyleSheet(QLabel *lb, QString color, QString border);
 
+    /*!
+     * \brief Méthode affichant le score et le nombre de lignes du joueur.
+     *
+     * \param score le score
+     * \param lines le nombre de lignes remplies
+     */
+    void showScore(unsigned score, unsigned lines);
+
     /*!
      * \brief Méthode permettant d'appeler les destructeurs des éléments
      * contenu dans un QGridLayout.
@@ -79,6 +98,26 @@ private:
      */
     void endGame();
 
+    /*!
+     * \brief Méthode écrivant la partie enregistrée dans le dossier des parties de l'application.
+     */
+    void saveReplay();
+
+    /*!
+     * \brief Méthode arrêtant la partie rejouée, s'il y en a une.
+     */
+    void stopReplay();
+
+    /*!
+     * \brief Méthode démarrant ou arrêtant la lecture des \ref GameEvent à chaque image.
+     *
+     * Les images ne sont lues que pendant que la partie avance ; à l'arrêt,
+     * les événements encore en attente sont affichés une dernière fois.
+     *
+     * \param running vrai si la partie avance, en jeu ou rejouée
+     */
+    void followEvents(bool running);
+
 private slots:
     /*!
      * \brief Méthode lançant la procédure de création de partie.
@@ -124,6 +163,40 @@ private slots:
      * \brief Méthode permettant d'afficher le temps écoulé hors pause depuis le début de la partie.
      */
     void showTime();
+
+    /*!
+     * \brief Méthode confiant la partie au \ref BotPlayer ou la rendant au joueur.
+     * \param checked vrai si le joueur automatique doit jouer
+     */
+    void setAutomatic(bool checked);
+
+    /*!
+     * \brief Méthode activant ou désactivant l'enregistrement des parties.
+     * \param checked vrai si les parties doivent être enregistrées
+     */
+    void setRecording(bool checked);
+
+    /*!
+     * \brief Méthode ouvrant une partie enregistrée et la rejouant en temps réel.
+     */
+    void showReplay();
+
+    /*!
+     * \brief Méthode rejouant la partie enregistrée jusqu'à la prochaine descente automatique.
+     */
+    void replayTick();
+
+    /*!
+     * \brief Méthode affichant le score et la prochaine \ref Bric s'ils ont changé
+     * depuis l'image précédente, sans relire le reste de la partie.
+     *
+     * Les \ref GameEvent sont publiés dans une \ref EventQueue par le jeu et
+     * lus ici à chaque image : plusieurs changements entre deux images ne
+     * sont affichés qu'une fois. Si des événements ont été perdus, le score et
+     * la prochaine brique sont relus dans la partie. Les images ne sont
+     * lues que pendant que la partie avance, voir \ref followEvents.
+     */
+    void showEvents();
 };
 
 #endif // MWTETRIS_H